@@ -4,12 +4,76 @@ import QtQuick.Controls.Basic
 import QtCharts
 
 ColumnLayout {
+    id: amplificationPlot
+
+    // The context property, read here since curveItem has a property of the same name
+    readonly property var liveDataManager: typeof dataManager !== "undefined" ? dataManager : null
+    readonly property var overlay: typeof experimentOverlay !== "undefined" ? experimentOverlay : null
+    readonly property bool currentPinned: overlay !== null && liveDataManager !== null
+                                          && overlay.pinnedNames.indexOf(liveDataManager.currentExperimentName) >= 0
+
     Rectangle {
         height: 100
         color: "red"
         border.width: 3
         border.color: "black"
         Layout.preferredWidth: 700
+
+        Text {
+            anchors.verticalCenter: parent.verticalCenter
+            leftPadding: 30
+            font.pointSize: 24
+            color: "white"
+
+            // Extrapolated from the exponential phase while the run goes on
+            text: {
+                if(typeof dataManager !== "undefined" && dataManager) {
+                    if(dataManager.predictedCt < 0) {
+                        return "Predicted Ct: -"
+                    }
+                    if(dataManager.predictedCtUncertainty > 0) {
+                        return "Predicted Ct: " + dataManager.predictedCt.toFixed(1)
+                               + " ± " + dataManager.predictedCtUncertainty.toFixed(1)
+                    }
+                    return "Ct: " + dataManager.predictedCt.toFixed(2)
+                }
+                return ""
+            }
+        }
+
+        RowLayout {
+            anchors.verticalCenter: parent.verticalCenter
+            anchors.right: parent.right
+            anchors.rightMargin: 20
+            spacing: 10
+
+            // Pinned experiments stay drawn over whichever experiment is loaded
+            Button {
+                text: amplificationPlot.currentPinned ? "Unpin" : "Pin"
+                font.pointSize: 14
+                enabled: amplificationPlot.overlay !== null
+                onClicked: {
+                    if(amplificationPlot.currentPinned) {
+                        experimentOverlay.unpin(dataManager.currentExperimentName)
+                    } else {
+                        experimentOverlay.pinCurrent()
+                    }
+                }
+            }
+
+            Button {
+                text: "Clear"
+                font.pointSize: 14
+                enabled: amplificationPlot.overlay !== null && experimentOverlay.pinnedCount > 0
+                onClicked: experimentOverlay.clear()
+            }
+
+            CheckBox {
+                id: logCheckBox
+                text: "Log"
+                font.pointSize: 18
+            }
+        }
     }
 
     Rectangle {
@@ -22,6 +86,7 @@ ColumnLayout {
             id: chart
             anchors.fill: parent
             antialiasing: true
+            legend.visible: false
 
 
             ValueAxis {
@@ -50,21 +115,65 @@ ColumnLayout {
             ValueAxis {
                 id: axisY
                 titleText: "Flourescence Intensity"
+                visible: !logCheckBox.checked
                 min: 0
+                max: curveItem.dataMaximum > 0 ? curveItem.dataMaximum * 1.1 : 100
             }
 
-            ScatterSeries { 
-                id: scatterSeries
+            LogValueAxis {
+                id: axisYLog
+                titleText: "Flourescence Intensity"
+                visible: logCheckBox.checked
+                labelFormat: "%g"
+                min: 1
+                max: curveItem.dataMaximum > 1 ? curveItem.dataMaximum * 1.1 : 100
+            }
+
+            // The series only hold the axes, the curves are drawn by curveItem
+            LineSeries {
                 name: "intensity"
                 axisX: axisX
                 axisY: axisY
-                
-                // Customize dot appearance
-                markerSize: 10
-                markerShape: ScatterSeries.MarkerShapeCircle
+            }
+
+            LineSeries {
+                axisX: axisX
+                axisY: axisYLog
+            }
+
+            AmplificationCurveItem {
+                id: curveItem
+                x: chart.plotArea.x
+                y: chart.plotArea.y
+                width: chart.plotArea.width
+                height: chart.plotArea.height
+                clip: true
+
+                dataManager: amplificationPlot.liveDataManager
+                overlay: amplificationPlot.overlay
                 color: "blue"
-                borderColor: "black"
-                borderWidth: 1
+                logScale: logCheckBox.checked
+                xMin: axisX.min
+                xMax: axisX.max
+                yMin: logScale ? axisYLog.min : axisY.min
+                yMax: logScale ? axisYLog.max : axisY.max
+            }
+
+            // Names of the pinned experiments in their curve colors
+            Column {
+                x: chart.plotArea.x + 10
+                y: chart.plotArea.y + 10
+                spacing: 2
+
+                Repeater {
+                    model: amplificationPlot.overlay ? amplificationPlot.overlay.pinnedNames : []
+
+                    Text {
+                        text: modelData.slice(0, -4)
+                        color: amplificationPlot.overlay.colorAt(index)
+                        font.pointSize: 10
+                    }
+                }
             }
 
             // Mouse Handling for Pan & Wheel Zoom
@@ -115,14 +224,5 @@ ColumnLayout {
                 }
             }
         }
-
-        VXYModelMapper {
-            id: modelMapper
-            model: rawDataModel
-            series: scatterSeries
-            xColumn: 0
-            yColumn: 1
-            firstRow: 1
-        }
     }
 }
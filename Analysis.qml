@@ -39,6 +39,18 @@ Rectangle {
 
                 font.pointSize: 24
             }
+            Text {
+                // 95% bootstrap interval
+                text: {
+                    if(dataManager && dataManager.interceptLower !== dataManager.interceptUpper) {
+                        return "[" + dataManager.interceptLower.toFixed(3) + ", " + dataManager.interceptUpper.toFixed(3) + "]"
+                    }
+                    return ""
+                }
+
+                font.pointSize: 18
+                color: "gray"
+            }
         }
 
         RowLayout {
@@ -58,6 +70,18 @@ Rectangle {
 
                 font.pointSize: 24
             }
+            Text {
+                // 95% bootstrap interval
+                text: {
+                    if(dataManager && dataManager.slopeLower !== dataManager.slopeUpper) {
+                        return "[" + dataManager.slopeLower.toFixed(3) + ", " + dataManager.slopeUpper.toFixed(3) + "]"
+                    }
+                    return ""
+                }
+
+                font.pointSize: 18
+                color: "gray"
+            }
         }
 
         RowLayout {
@@ -77,6 +101,18 @@ Rectangle {
 
                 font.pointSize: 24
             }
+            Text {
+                // 95% bootstrap interval
+                text: {
+                    if(dataManager && dataManager.efficiencyLower !== dataManager.efficiencyUpper) {
+                        return "[" + dataManager.efficiencyLower.toFixed(1) + ", " + dataManager.efficiencyUpper.toFixed(1) + "]%"
+                    }
+                    return ""
+                }
+
+                font.pointSize: 18
+                color: "gray"
+            }
         }
 
         RowLayout {
@@ -89,7 +125,7 @@ Rectangle {
             Text {
                 text: {
                     if(dataManager) {
-                        return String(dataManager.cycleThreshold)
+                        return dataManager.cycleThreshold.toFixed(2)
                     }
                     return ""
                 }
@@ -97,6 +133,73 @@ Rectangle {
                 font.pointSize: 24
             }
         }
+
+        RowLayout {
+            Text {
+                text: "Replicates = "
+                font.pointSize: 24
+                leftPadding: 30
+            }
+
+            Text {
+                text: {
+                    if(dataManager && dataManager.replicateCount > 0) {
+                        return "n = " + dataManager.replicateCount + ", Ct " + dataManager.replicateMeanCt.toFixed(2)
+                                + " ± " + dataManager.replicateSd.toFixed(2)
+                                + " (CV " + dataManager.replicateCv.toFixed(1) + "%)"
+                    }
+                    return "-"
+                }
+
+                font.pointSize: 24
+            }
+        }
+
+        RowLayout {
+            Text {
+                text: "Run Ended = "
+                font.pointSize: 24
+                leftPadding: 30
+            }
+
+            Text {
+                text: {
+                    if(dataManager) {
+                        if(dataManager.stopReason === "plateau") {
+                            return "early, at plateau"
+                        }
+                        else if(dataManager.stopReason === "max_cycle") {
+                            return "at max cycle"
+                        }
+                        else if(dataManager.stopReason === "user") {
+                            return "stopped by user"
+                        }
+                    }
+                    return "-"
+                }
+
+                font.pointSize: 24
+            }
+        }
+
+        RowLayout {
+            Text {
+                text: "Melting Temperature = "
+                font.pointSize: 24
+                leftPadding: 30
+            }
+
+            Text {
+                text: {
+                    if(dataManager && dataManager.meltingTemperature > 0) {
+                        return dataManager.meltingTemperature.toFixed(2) + " °C"
+                    }
+                    return "-"
+                }
+
+                font.pointSize: 24
+            }
+        }
     }
 
 }
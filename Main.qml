@@ -146,6 +146,16 @@ Window {
                     palette.button: "red"
                     enabled: !window.blockRun
 
+                    // A run that ends by itself puts the button back, like clicking "Stop" does
+                    Connections {
+                        target: (typeof buttonHandler !== "undefined") ? buttonHandler : null
+                        function onRunFinished() {
+                            runButton.text = "Run"
+                            stateManager.changeCurrentState(runButton.text)
+                            window.inputBlocked = false
+                        }
+                    }
+
                     onClicked: {
                         // Event filter (in RunButtonEventFilter.cpp)
                         // being executed before onClicked.
@@ -289,14 +299,22 @@ Window {
                         font.pixelSize: 30
                         implicitWidth: 350
 
-                        model: experimentModel
+                        // Sorted and filtered, rows are mapped back before ExperimentModel is called
+                        model: experimentProxyModel
                         editable: true
                         textRole: "experimentName"
                         enabled: !window.inputBlocked
 
                         onActivated: (index) => {
                             if (index >= 0) {
-                                experimentModel.loadExperiment(index)
+                                experimentModel.loadExperiment(experimentProxyModel.sourceRow(index))
+                            }
+                        }
+
+                        // Keep the loaded experiment shown when the rows move under it
+                        function showCurrentExperiment() {
+                            if (dataManager) {
+                                currentIndex = find(dataManager.currentExperimentName.slice(0, -4))
                             }
                         }
 
@@ -315,7 +333,7 @@ Window {
                         Component.onCompleted: {
                             if (count > 0) {
                                 currentIndex = 0
-                                experimentModel.loadExperiment(0)
+                                experimentModel.loadExperiment(experimentProxyModel.sourceRow(0))
                             }
                         }
                     }
@@ -347,14 +365,14 @@ Window {
                                 var idx = myComboBox.currentIndex
                                 if (idx >= 0) {
                                     // Remove (and Auto-Add if last item)
-                                    experimentModel.removeEntry(idx)
+                                    experimentModel.removeEntry(experimentProxyModel.sourceRow(idx))
 
                                     // Select the correct item
                                     // If we deleted the last item and it auto-created a new one,
                                     // count will be 1, so we select 0.
                                     if (myComboBox.count > 0) {
                                         myComboBox.currentIndex = 0
-                                        experimentModel.loadExperiment(0)
+                                        experimentModel.loadExperiment(experimentProxyModel.sourceRow(0))
                                     } else {
                                         // This block should technically never be reached
                                         // if the auto-create logic works
@@ -364,6 +382,37 @@ Window {
                             }
                         }
                     }
+
+                    TextField {
+                        id: filterField
+                        width: 170
+                        height: 50
+                        font.pixelSize: 20
+                        placeholderText: "Filter"
+                        enabled: !window.inputBlocked
+
+                        // Filtered as the user types, each key only retests the names that still match
+                        onTextChanged: {
+                            experimentProxyModel.filterText = text
+                            myComboBox.showCurrentExperiment()
+                        }
+                    }
+
+                    ComboBox {
+                        id: sortComboBox
+                        width: 190
+                        height: 50
+                        font.pixelSize: 20
+                        model: ["Name", "Newest", "R²", "Efficiency"]
+                        enabled: !window.inputBlocked
+
+                        // Same order as ExperimentProxyModel.SortKey, names ascending, the rest newest or highest first
+                        onActivated: (index) => {
+                            experimentProxyModel.sortKey = index
+                            experimentProxyModel.descending = index !== 0
+                            myComboBox.showCurrentExperiment()
+                        }
+                    }
                 }
             }
 
@@ -58,10 +58,14 @@ ColumnLayout {
             Layout.minimumWidth: 20
             font.pointSize: 24
             background: Rectangle { color: "gray" }
+            // An automatic threshold follows the baseline noise of every run
+            enabled: !autoThresholdCheckBox.checked
 
+            // Shows the automatic delta above the baseline while Auto is checked
             text: {
                 if(typeof dataManager !== "undefined" && dataManager) {
-                    return dataManager.intensityThreshold
+                    return autoThresholdCheckBox.checked ? dataManager.autoThresholdDelta
+                                                         : dataManager.intensityThreshold
                 }
                 return "0"
             }
@@ -78,12 +82,30 @@ ColumnLayout {
             onTextChanged: {
                 var val = parseFloat(text)
 
-                // Make sure val is not NaN
-                if(typeof dataManager !== "undefined" && dataManager && (val || val === 0)) {
+                // Make sure val is not NaN, and never write the automatic delta over the manual threshold
+                if(typeof dataManager !== "undefined" && dataManager && !autoThresholdCheckBox.checked
+                        && (val || val === 0)) {
                     dataManager.intensityThreshold = val
                 }
             }
         }
+
+        CheckBox {
+            id: autoThresholdCheckBox
+            text: "Auto"
+            font.pointSize: 24
+
+            checked: (typeof dataManager !== "undefined" && dataManager)
+                     ? dataManager.autoThreshold
+                     : false
+
+            onToggled: {
+                if(typeof dataManager !== "undefined" && dataManager) {
+                    dataManager.autoThreshold = checked
+                    dataManager.estimateBaseline()
+                }
+            }
+        }
     }
 
     RowLayout {
@@ -295,6 +317,112 @@ ColumnLayout {
                 }
             }
 
+            RowLayout {
+                Text {
+                    text: "Sample: "
+                    font.pointSize: 24
+                    leftPadding: 30
+                }
+
+                ComboBox {
+                    id: sampleTypeInput
+                    Layout.preferredWidth: 175
+                    Layout.minimumHeight: 55
+                    font.pointSize: 14
+                    background: Rectangle {
+                        color: "gray"
+                        height: parent.height
+                    }
+
+                    // An unknown is quantified against the standard curve instead of adding a point to it
+                    model: ["Standard", "Unknown"]
+                    property var sampleTypes: ["standard", "unknown"]
+
+                    currentIndex: {
+                        if (typeof dataManager !== "undefined" && dataManager) {
+                            return Math.max(0, sampleTypes.indexOf(dataManager.sampleType))
+                        }
+                        return 0
+                    }
+
+                    onActivated: {
+                        if (typeof dataManager !== "undefined" && dataManager) {
+                            dataManager.setSampleType(sampleTypes[currentIndex])
+                            dataManager.updateCurrentExperiment()
+                        }
+                    }
+                }
+
+                CheckBox {
+                    id: meltCheckBox
+                    // Temperature ramp after the last cycle, for the melting temperature of the product
+                    text: "Melt curve"
+                    font.pointSize: 24
+                    Layout.leftMargin: 30
+
+                    checked: (typeof dataManager !== "undefined" && dataManager)
+                             ? dataManager.meltEnabled
+                             : false
+
+                    onToggled: {
+                        if(typeof dataManager !== "undefined" && dataManager) {
+                            dataManager.meltEnabled = checked
+                            dataManager.updateCurrentExperiment()
+                        }
+                    }
+                }
+
+                CheckBox {
+                    id: earlyStopCheckBox
+                    // End the run once the curve is past Ct and has stopped rising
+                    text: "Stop at plateau"
+                    font.pointSize: 24
+
+                    checked: (typeof dataManager !== "undefined" && dataManager)
+                             ? dataManager.earlyStop
+                             : false
+
+                    onToggled: {
+                        if(typeof dataManager !== "undefined" && dataManager) {
+                            dataManager.earlyStop = checked
+                            dataManager.updateCurrentExperiment()
+                        }
+                    }
+                }
+            }
+
+            RowLayout {
+                Text {
+                    text: "Replicate group: "
+                    font.pointSize: 24
+                    leftPadding: 30
+                }
+
+                TextField {
+                    id: replicateGroupInput
+                    background: Rectangle { color: "gray" }
+                    Layout.minimumWidth: 200
+                    font.pointSize: 24
+                    // Runs with the same group are replicates, empty for none
+                    placeholderText: "none"
+
+                    text: {
+                        if(typeof dataManager !== "undefined" && dataManager) {
+                            return dataManager.replicateGroup
+                        }
+                        return ""
+                    }
+
+                    onEditingFinished: {
+                        focus = false
+                        if(typeof dataManager !== "undefined" && dataManager) {
+                            dataManager.replicateGroup = text.trim()
+                            dataManager.updateCurrentExperiment()
+                        }
+                    }
+                }
+            }
+
             Button {
                 text: "Reset data"
                 font.pointSize: 24
@@ -1,6 +1,7 @@
 import QtQuick
 import QtCharts
 import QtQuick.Layouts
+import QtQuick.Controls.Basic
 
 ColumnLayout {
     Rectangle {
@@ -9,9 +10,70 @@ ColumnLayout {
         border.width: 3
         border.color: "black"
         Layout.preferredWidth: 700
+
+        RowLayout {
+            anchors.fill: parent
+            anchors.leftMargin: 20
+            anchors.rightMargin: 20
+
+            // Experiments, active or archived, to build one standard curve from
+            ListView {
+                id: experimentSelection
+                Layout.fillWidth: true
+                Layout.preferredHeight: 60
+                orientation: ListView.Horizontal
+                clip: true
+                spacing: 10
+                model: (typeof experimentModel !== "undefined" && experimentModel) ? experimentModel : null
+
+                delegate: CheckBox {
+                    text: model.experimentName
+                    font.pointSize: 14
+                    checked: model.selected
+
+                    onToggled: {
+                        experimentModel.setSelected(index, checked)
+                        buildButton.enabled = experimentModel.selectedCount() > 0
+                    }
+                }
+            }
+
+            Button {
+                id: buildButton
+                text: "Build from selected"
+                font.pointSize: 18
+                enabled: false
+
+                onClicked: {
+                    if(typeof experimentModel !== "undefined" && experimentModel) {
+                        experimentModel.buildStandardCurve()
+                    }
+                }
+
+                // The selection outlives the page
+                Component.onCompleted: {
+                    if(typeof experimentModel !== "undefined" && experimentModel) {
+                        enabled = experimentModel.selectedCount() > 0
+                    }
+                }
+            }
+
+            Button {
+                // One point per replicate group of standards, at the mean Ct of its runs
+                text: "Use replicate means"
+                font.pointSize: 18
+
+                onClicked: {
+                    if(typeof dataManager !== "undefined" && dataManager) {
+                        dataManager.useReplicateMeans()
+                    }
+                }
+            }
+        }
     }
 
     Rectangle {
+        id: chartFrame
         Layout.preferredHeight: 340
         Layout.preferredWidth: 700
 
@@ -42,6 +104,15 @@ ColumnLayout {
                 markerSize: 10 // Make points easier to see
             }
 
+            // Fitted line, two points, redrawn only when the fit changes
+            LineSeries {
+                id: fitSeries
+                name: "Fit"
+                axisX: axisX
+                axisY: axisY
+                width: 2
+            }
+
             // Mouse Handling for Wheel Zoom & Panning
             MouseArea {
                 anchors.fill: parent
@@ -90,6 +161,23 @@ ColumnLayout {
             }
         }
 
+        function updateFitLine() {
+            fitSeries.clear()
+            if(typeof standardCurveModel !== "undefined" && standardCurveModel && standardCurveModel.fitValid) {
+                fitSeries.append(standardCurveModel.fitStart.x, standardCurveModel.fitStart.y)
+                fitSeries.append(standardCurveModel.fitEnd.x, standardCurveModel.fitEnd.y)
+            }
+        }
+
+        Connections {
+            target: (typeof standardCurveModel !== "undefined") ? standardCurveModel : null
+            function onFitChanged() {
+                chartFrame.updateFitLine()
+            }
+        }
+
+        Component.onCompleted: updateFitLine()
+
         VXYModelMapper {
             id: modelMapper
 
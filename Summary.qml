@@ -1,15 +1,64 @@
 import QtQuick
+import QtQuick.Layouts
 
 Item {
-    Text {
-        text: {
-            if(dataManager) {
-                return dataManager.summary
+    ColumnLayout {
+        Text {
+            text: {
+                if(dataManager) {
+                    return dataManager.summary
+                }
+                return ""
             }
-            return ""
+
+            font.pointSize: 24
+            leftPadding: 30
+        }
+
+        Text {
+            text: {
+                if(typeof dataManager !== "undefined" && dataManager) {
+                    return dataManager.quantification
+                }
+                return ""
+            }
+
+            font.pointSize: 24
+            leftPadding: 30
+            Layout.topMargin: 20
+        }
+
+        Text {
+            text: {
+                if(typeof dataManager !== "undefined" && dataManager) {
+                    return dataManager.replicateSummary
+                }
+                return ""
+            }
+
+            font.pointSize: 24
+            leftPadding: 30
+            Layout.topMargin: 20
+        }
+    }
+
+    // The quantities follow the curve, the Ct of the current run and whether it is an unknown
+    Connections {
+        target: (typeof dataManager !== "undefined") ? dataManager : null
+        function onStandardCurveFitChanged() {
+            dataManager.quantifyUnknowns()
         }
+        function onCycleThresholdChanged() {
+            dataManager.quantifyUnknowns()
+        }
+        function onSampleTypeChanged() {
+            dataManager.quantifyUnknowns()
+        }
+    }
 
-        font.pointSize: 24
-        leftPadding: 30
+    Component.onCompleted: {
+        if(typeof dataManager !== "undefined" && dataManager) {
+            dataManager.quantifyUnknowns()
+        }
     }
 }
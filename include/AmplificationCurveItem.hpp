@@ -0,0 +1,161 @@
+#pragma once
+
+#include "DataManager.hpp"
+
+#include <qqml.h>
+#include <QColor>
+#include <QList>
+#include <QPointer>
+#include <QQuickItem>
+#include <QSharedPointer>
+
+#include <climits>
+#include <vector>
+
+class ExperimentOverlay;
+class QSGGeometryNode;
+
+// A complete curve drawn along with the live one, one reading per cycle
+struct PlotCurve
+{
+    QSharedPointer<const QList<float>> values;
+    QColor color;
+};
+
+/**
+ * Amplification curves drawn straight into the scene graph, in place of a
+ * QtCharts series fed through a model mapper.
+ *
+ * The live curve is read from DataManager's intensity list, other curves from
+ * shared read-only lists, and every curve is one QSGGeometryNode whose line
+ * strip is written from those lists directly. Reading k is drawn at cycle
+ * k + 1, and xMin..xMax, yMin..yMax map onto the item, so it can lie over the
+ * plot area of a ChartView that draws the axes.
+ *
+ * --------------------------------------------------------------------------------------
+ * A curve with no more than two points per pixel column is drawn as it is.
+ * Past that the live curve is decimated min-max and every other curve with
+ * LTTB (see CurveDecimator), so a node never has more than about two vertices
+ * per column whatever the number of readings.
+ *
+ * A new reading only marks its own curve from that index on, and is written
+ * into the vertex buffer of that one node: a single vertex while drawn as it
+ * is, or the one min-max column it falls into. The node is reallocated only
+ * when it gains a vertex. The other curves, 96 wells or pinned experiments,
+ * are not touched until the size, the ranges or the scale change. With
+ * logScale the y axis is log10, readings at or below zero are drawn at yMin.
+ * ======================================================================================
+ */
+class AmplificationCurveItem : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(DataManager* dataManager READ dataManager WRITE setDataManager NOTIFY dataManagerChanged)
+    Q_PROPERTY(double xMin READ xMin WRITE setXMin NOTIFY rangeChanged)
+    Q_PROPERTY(double xMax READ xMax WRITE setXMax NOTIFY rangeChanged)
+    Q_PROPERTY(double yMin READ yMin WRITE setYMin NOTIFY rangeChanged)
+    Q_PROPERTY(double yMax READ yMax WRITE setYMax NOTIFY rangeChanged)
+    Q_PROPERTY(bool logScale READ logScale WRITE setLogScale NOTIFY logScaleChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    // Pinned experiments, drawn through setCurves()
+    Q_PROPERTY(ExperimentOverlay* overlay READ overlay WRITE setOverlay NOTIFY overlayChanged)
+    // Highest reading of all curves, for the y axis
+    Q_PROPERTY(double dataMaximum READ dataMaximum NOTIFY dataMaximumChanged)
+
+public:
+    explicit AmplificationCurveItem(QQuickItem* parent = nullptr);
+
+    DataManager* dataManager() const;
+    void setDataManager(DataManager* dataManager);
+    double xMin() const;
+    void setXMin(double xMin);
+    double xMax() const;
+    void setXMax(double xMax);
+    double yMin() const;
+    void setYMin(double yMin);
+    double yMax() const;
+    void setYMax(double yMax);
+    bool logScale() const;
+    void setLogScale(bool logScale);
+    QColor color() const;
+    void setColor(const QColor& color);
+    ExperimentOverlay* overlay() const;
+    void setOverlay(ExperimentOverlay* overlay);
+    double dataMaximum() const;
+
+    // Curves drawn besides the live one, replacing the previous ones
+    void setCurves(const QList<PlotCurve>& curves);
+
+signals:
+    void dataManagerChanged();
+    void rangeChanged();
+    void logScaleChanged();
+    void colorChanged();
+    void overlayChanged();
+    void dataMaximumChanged();
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private slots:
+    void onIntensityValueUpdated(int index, float value);
+    // A new run, nothing read yet
+    void onIntensityValuesReset();
+    // Another experiment or another number of cycles
+    void onIntensityValuesReloaded();
+    void onOverlayCurvesChanged();
+
+private:
+    enum class Mode
+    {
+        Raw,
+        MinMax,
+        Lttb
+    };
+
+    struct Curve
+    {
+        // Null for the live curve, which is DataManager's intensity list
+        QSharedPointer<const QList<float>> values;
+        QColor color;
+        Mode mode{Mode::Raw};
+        bool rebuild{true};
+        // Lowest reading changed since the last frame, INT_MAX when none
+        int dirtyFrom{INT_MAX};
+        // Readings drawn last frame
+        int drawnCount{0};
+        // Min-max columns in pixels, NaN where empty
+        std::vector<float> columnMinimum;
+        std::vector<float> columnMaximum;
+        int lastColumn{-1};
+    };
+
+    const QList<float>& valuesOf(const Curve& curve) const;
+    int countOf(const Curve& curve) const;
+    float mapX(int index) const;
+    float mapY(float value) const;
+    void invalidateAll();
+    void recomputeDataMaximum();
+
+    void rebuildCurve(Curve& curve, QSGGeometryNode* node);
+    void updateCurve(Curve& curve, QSGGeometryNode* node);
+    void updateColumn(Curve& curve, int column, const QList<float>& values, int count);
+    void writeColumns(const Curve& curve, QSGGeometryNode* node, int firstColumn, int lastColumn) const;
+
+    QPointer<DataManager> m_dataManager;
+    QPointer<ExperimentOverlay> m_overlay;
+    // Readings of the live curve so far, the rest of DataManager's list is not read yet
+    int m_liveCount{0};
+    double m_xMin{1.0};
+    double m_xMax{30.0};
+    double m_yMin{0.0};
+    double m_yMax{100.0};
+    bool m_logScale{false};
+    QColor m_color{Qt::blue};
+    double m_dataMaximum{0.0};
+    // Live curve first, then the ones given to setCurves
+    std::vector<Curve> m_curves;
+    bool m_nodesChanged{true};
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QList>
+
+struct BaselineEstimate
+{
+    bool valid{false};
+    // Baseline line over 1-based cycles, value = intercept + slope * cycle
+    double intercept{0.0};
+    double slope{0.0};
+    // Robust standard deviation of the baseline readings around that line
+    double noise{0.0};
+    // Intensity above the baseline that counts as amplified
+    double threshold{0.0};
+
+    double valueAt(double cycle) const;
+};
+
+/**
+ * Baseline of an amplification curve from its early cycles, and a threshold
+ * derived from the baseline noise instead of a fixed lux value.
+ *
+ * Math Representation (Theil–Sen over the window cycles x_i):
+ *
+ * slope     = median over i < j of (y_j - y_i) / (x_j - x_i)
+ * intercept = median of (y_i - slope * x_i)
+ * σ         = 1.4826 * median |y_i - intercept - slope * x_i|
+ * threshold = 10 σ
+ *
+ * --------------------------------------------------------------------------------------
+ * Medians ignore a reading that spikes or a window whose last cycles already
+ * start to rise, a least squares line would follow them. The window holds at
+ * most 13 cycles (78 slopes), everything fits in fixed arrays on the stack and
+ * the estimate is cheap enough to redo after every new reading.
+ *
+ * σ is kept above 0.1% of the baseline level, so a perfectly flat (simulated or
+ * saturated) baseline does not give a zero threshold that every cycle crosses.
+ * ======================================================================================
+ */
+class BaselineEstimator
+{
+public:
+    // The first cycles often drift while the block and the LED settle
+    static constexpr int FIRST_CYCLE = 3;
+    static constexpr int LAST_CYCLE = 15;
+    static constexpr int MIN_POINTS = 5;
+    static constexpr double NOISE_MULTIPLIER = 10.0;
+
+    // Only the first sampleCount readings are used, the rest of the run is still to come
+    static BaselineEstimate estimate(const QList<float>& intensityValues, int sampleCount);
+    static QList<float> subtract(const QList<float>& intensityValues, const BaselineEstimate& baseline);
+};
@@ -17,9 +17,13 @@ public:
     ButtonHandler(QSharedPointer<DataManager> dm, QSharedPointer<HardwareController> hwc, QObject* parent = nullptr);
     void handleRunStart();
     void handleRunStop();
+    // The run ended by itself (last cycle, plateau or end of the melt ramp)
+    void finishRun();
 
 signals:
     void exitApp();
+    // The run button has to go back to "Run"
+    void runFinished();
 
 public slots:
     void handleButtonClick(const QString &buttonName);
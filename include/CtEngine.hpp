@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QList>
+
+#include <vector>
+
+/**
+ * Fractional Ct (cycle threshold) of many reactions at once.
+ *
+ * Curves are stored as a structure of arrays, cycle-major:
+ *   value(cycle, well) = m_values[cycle * wellCount + well]
+ * so finding the first cycle at or above the threshold walks one contiguous row
+ * per cycle, and the loop over wells is a branch-free compare/min that the
+ * compiler vectorizes. Only that first crossing is interpolated afterwards, once
+ * per well.
+ *
+ * Math Representation (k = last 1-based cycle below the threshold T):
+ *
+ * Linear:      Ct = k + (T - F_k) / (F_(k+1) - F_k)
+ * Log-linear:  Ct = k + (ln T - ln F_k) / (ln F_(k+1) - ln F_k)
+ *
+ * Log-linear follows the exponential phase of the reaction more closely, it
+ * falls back to linear when F_k is not positive. A well already at or above the
+ * threshold on the first cycle has Ct = 1, like the whole cycle scan.
+ * ======================================================================================
+ */
+class CtEngine
+{
+public:
+    enum class Interpolation {
+        Linear,
+        LogLinear
+    };
+
+    CtEngine(int wellCount, int cycleCount);
+
+    int wellCount() const;
+    int cycleCount() const;
+
+    // Copy one amplification curve into a well, cycles past its end read as 0
+    void setCurve(int well, const QList<float>& intensityValues);
+    // Readings of every well on one (0-based) cycle, wellCount() values
+    float* cycleValues(int cycle);
+
+    // Ct of every well, -1 where the threshold is never reached
+    void computeCt(double intensityThreshold, Interpolation interpolation, std::vector<double>& ct);
+
+    // Ct of a single curve, same result as a one-well engine
+    static double findCycleThreshold(const QList<float>& intensityValues, double intensityThreshold,
+                                     Interpolation interpolation = Interpolation::Linear);
+
+private:
+    // Smallest float not below the threshold, so comparing floats gives the same answer as comparing doubles
+    static float floatThreshold(double intensityThreshold);
+    static double interpolate(float before, float after, double intensityThreshold, Interpolation interpolation);
+
+    int m_wellCount;
+    int m_cycleCount;
+    std::vector<float> m_values;
+    // First 0-based cycle at or above the threshold per well, reused between calls
+    std::vector<int> m_firstCrossing;
+};
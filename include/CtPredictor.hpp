@@ -0,0 +1,67 @@
+#pragma once
+
+#include "BaselineEstimator.hpp"
+#include "RegressionAccumulator.hpp"
+
+#include <array>
+
+struct CtPrediction
+{
+    bool valid{false};
+    // The threshold was actually crossed, cycleThreshold is then the measured Ct
+    bool crossed{false};
+    double cycleThreshold{-1.0};
+    // One standard deviation, cycles
+    double uncertainty{0.0};
+};
+
+/**
+ * Ct of a run that is still going, extrapolated from its exponential phase.
+ *
+ * Math Representation (window of the last W significant readings):
+ *
+ * ln(F_k - baseline_k) = b + m k           (least squares over the window)
+ * Ct   = (ln(T - baseline) - b) / m
+ * s_Ct = (s / m) * √(1/n + (ln(T - baseline) - ȳ)² / Sxx),  s² = RSS / (n - 2)
+ *
+ * --------------------------------------------------------------------------------------
+ * A reading is significant when it is more than 3 baseline σ above the baseline;
+ * an insignificant one empties the window, the exponential phase has to be
+ * contiguous. The window is a RegressionAccumulator, the oldest point is removed
+ * as the newest one is added, so a sample costs O(1) whatever the run length.
+ * Fits that do not grow by between 1.2x and 2.5x per cycle are not an
+ * exponential phase and give no prediction.
+ *
+ * s_Ct only covers the scatter around the line. The exponential phase starts to
+ * bend a few cycles before Ct, so the prediction drifts later as Ct comes close
+ * (25.2 five cycles ahead, 25.6 one cycle ahead of a measured 25.9 on a noisy
+ * simulated sigmoid). Once a reading reaches the threshold the prediction
+ * becomes the measured Ct, linearly interpolated like CtEngine, with no
+ * uncertainty.
+ * ======================================================================================
+ */
+class CtPredictor
+{
+public:
+    static constexpr int WINDOW = 5;
+    static constexpr double MIN_SIGNAL_SIGMAS = 3.0;
+    static constexpr double MIN_GROWTH = 1.2;
+    static constexpr double MAX_GROWTH = 2.5;
+
+    void reset();
+    // Reading of a 1-based cycle, threshold in the same units as the reading
+    CtPrediction add(int cycle, float value, const BaselineEstimate& baseline, double threshold);
+    const CtPrediction& prediction() const;
+
+private:
+    void clearWindow();
+
+    RegressionAccumulator m_window;
+    // Points of m_window, oldest at m_first
+    std::array<double, WINDOW> m_cycles{};
+    std::array<double, WINDOW> m_logSignals{};
+    int m_first{0};
+    int m_previousCycle{0};
+    float m_previousValue{0.0f};
+    CtPrediction m_prediction;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Fewer points for a curve that has more of them than there are pixels to draw
+ * them on, without losing what the eye would see.
+ *
+ * Largest Triangle Three Buckets (Steinarsson, 2013): the points between the
+ * first and the last are split into threshold - 2 buckets, and each bucket
+ * keeps the point that spans the largest triangle with the point kept from the
+ * bucket before and the average of the bucket after:
+ *
+ * area = |(x_a - x_c)(y_p - y_a) - (x_a - x_p)(y_c - y_a)| / 2
+ *
+ * Min-max: every pixel column keeps the lowest and the highest point falling
+ * into it, drawn as one vertical segment.
+ *
+ * --------------------------------------------------------------------------------------
+ * Both work on coordinates that are already in pixels, so LTTB weighs the
+ * triangles as they appear on screen, log scale included. LTTB keeps the shape
+ * of a line better and suits curves that are complete. Min-max is what a curve
+ * still being read needs: a new point only changes the column it falls into.
+ * ======================================================================================
+ */
+class CurveDecimator
+{
+public:
+    // Indices of the kept points in order, all of them when count <= threshold or threshold < 3
+    static std::vector<int> largestTriangleThreeBuckets(const float* x, const float* y, int count, int threshold);
+
+    // minimum and maximum receive columnCount values, NaN for a column no point falls into.
+    // A point falls into column floor(x), points outside [0, columnCount) are left out
+    static void minMax(const float* x, const float* y, int count, int columnCount,
+                       float* minimum, float* maximum);
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "fkYAML.hpp"
+
+#include <QList>
+#include <QThreadPool>
+
+#include <array>
+
+struct CurveFit
+{
+    bool converged{false};
+    // 4 or 5, 0 when the curve could not be fitted at all
+    int parameterCount{0};
+    double baseline{0.0};
+    double amplitude{0.0};
+    double midpoint{0.0};
+    double scale{0.0};
+    double asymmetry{1.0};
+    double rss{0.0};
+    int iterations{0};
+
+    // Derived from the parameters above
+    double plateau{0.0};
+    double secondDerivativeMaximum{0.0};
+    double efficiency{0.0};
+};
+
+/**
+ * Sigmoid fit of a whole amplification curve, cycles are 1-based like Ct.
+ *
+ * Math Representation (5PL, asymmetry g = 1 gives the 4PL):
+ *
+ * F(x) = y0 + A / (1 + e)^g,  e = exp(-(x - c) / b)
+ *
+ * ∂F/∂y0 = 1
+ * ∂F/∂A  = (1 + e)^-g
+ * ∂F/∂c  = -A g e (1 + e)^(-g-1) / b
+ * ∂F/∂b  = -A g e (1 + e)^(-g-1) (x - c) / b²
+ * ∂F/∂g  = -A (1 + e)^-g ln(1 + e)
+ *
+ * Levenberg–Marquardt step, J the Jacobian above and r the residuals:
+ *
+ * (JᵀJ + λ diag(JᵀJ)) δ = Jᵀr
+ *
+ * JᵀJ and Jᵀr are accumulated point by point, J itself is never stored, so a fit
+ * only needs a few fixed size arrays on the stack whatever the cycle count.
+ *
+ * --------------------------------------------------------------------------------------
+ * Second derivative maximum (Cq), where F'' = A g e (g e - 1) / (b² (1 + e)^(g+2))
+ * peaks, has a closed form:
+ *
+ * g² e² - (3g + 1) e + 1 = 0  =>  e* = (3g + 1 + √((3g + 1)² - 4g²)) / (2g²)
+ * Cq = c - b ln e*
+ *
+ * and the efficiency of that cycle is (F(Cq) - y0) / (F(Cq - 1) - y0) - 1.
+ * ======================================================================================
+ */
+class CurveFitter
+{
+public:
+    enum class Model {
+        FourParameter,
+        FiveParameter
+    };
+
+    // The 5PL starts from the 4PL fit and falls back to it when it does not do better
+    static CurveFit fit(const QList<float>& intensityValues, Model model = Model::FiveParameter);
+    // One fit per curve, spread over the threads of the pool, results in input order.
+    // Returns once these fits are done, without waiting for other work on the pool
+    static QList<CurveFit> fitBatch(const QList<QList<float>>& curves, QThreadPool& pool,
+                                    Model model = Model::FiveParameter);
+
+    static double evaluate(const CurveFit& curveFit, double cycle);
+
+    // "curve_fit" mapping of the experiment files
+    static fkyaml::node toNode(const CurveFit& curveFit);
+    static CurveFit fromNode(const fkyaml::node& node);
+
+private:
+    static constexpr int MAX_PARAMETERS = 5;
+    using Parameters = std::array<double, MAX_PARAMETERS>;
+
+    static bool initialGuess(const QList<float>& intensityValues, Parameters& parameters);
+    static bool levenbergMarquardt(const QList<float>& intensityValues, int parameterCount,
+                                   Parameters& parameters, double& rss, int& iterations);
+    static double residualSumOfSquares(const QList<float>& intensityValues, const Parameters& parameters);
+    static bool isValid(const Parameters& parameters);
+    static void setDerivedValues(CurveFit& curveFit);
+};
@@ -1,11 +1,28 @@
 #pragma once
 
 #include "fkYAML.hpp"
+#include "ExperimentArchive.hpp"
+#include "BaselineEstimator.hpp"
+#include "CtPredictor.hpp"
+#include "CurveFitter.hpp"
+#include "MeltAnalyzer.hpp"
+#include "PlateauDetector.hpp"
+#include "Quantification.hpp"
+#include "RegressionAccumulator.hpp"
+#include "ReplicateGroups.hpp"
+#include "RobustRegression.hpp"
+#include "StandardCurveBootstrap.hpp"
+#include "StandardCurveBuilder.hpp"
+#include "UpdateCoalescer.hpp"
 
 #include <QObject>
 #include <QList>
 #include <QPair>
 #include <QMap>
+#include <QSharedPointer>
+#include <QThreadPool>
+
+#include <atomic>
 
 #include <string>
 
@@ -24,15 +41,38 @@ public:
     // Timestamp when the experiment is last saved
     std::string m_lastSaved;
     // Ct value
-    int m_cycleThreshold;
+    double m_cycleThreshold;
+    // Sigmoid fit of the amplification curve, stored next to the Ct
+    CurveFit m_curveFit;
     // Minimum light intensity so note the sample as "amplified"
     double m_intensityThreshold;
+    // Pick the threshold from the baseline noise instead of m_intensityThreshold
+    bool m_autoThreshold;
+    // Automatic threshold, measured above the baseline. Kept apart so m_intensityThreshold stays the manual one
+    double m_autoThresholdDelta;
+    BaselineEstimate m_baseline;
+    // Run a melt ramp once the amplification cycles are done
+    bool m_meltEnabled;
+    // Fed sample by sample during the ramp
+    MeltAnalyzer m_meltAnalyzer;
+    double m_meltingTemperature;
+    // End the amplification as soon as the curve has plateaued
+    bool m_earlyStop;
+    PlateauDetector m_plateauDetector;
+    // Live Ct while the run is going, -1 while there is no exponential phase to extrapolate yet
+    CtPredictor m_ctPredictor;
+    double m_predictedCt;
+    double m_predictedCtUncertainty;
+    // Why the last run ended: "plateau", "max_cycle" or "user", empty while running
+    QString m_stopReason;
 
     // experiment names or key of m_experiments always have ".yml"
     QMap<QString, fkyaml::node> m_experiments;
     fkyaml::node m_currentExperiment;
     QString m_currentExperimentName;
     QList<QString> m_experimentNames;
+    // Compressed tier for experiments that have not been opened for a while
+    QSharedPointer<ExperimentArchive> m_archive;
 
     // Use QString for display on setup,
     // convert to float later for processing
@@ -45,7 +85,32 @@ public:
     double m_slope;
     double m_percentEfficiency;
     QString m_summary;
-    QList<QPair<double, int>> m_xyLogStandardCurve;
+    // Kept sorted by log concentration
+    QList<QPair<double, double>> m_xyLogStandardCurve;
+    // Fit over m_xyLogStandardCurve, updated point by point
+    RegressionAccumulator m_regression;
+    // Flags the points of m_xyLogStandardCurve that look like outliers, the reported curve is m_regression
+    RobustFit m_robustFit;
+    // 95% intervals of the reported fit, empty while they are being resampled
+    StandardCurveIntervals m_standardCurveIntervals;
+    // Own pool, so the resamples never queue behind anybody else's work
+    QThreadPool m_bootstrapPool;
+    // Runs the bootstrap off the GUI thread, one at a time, so quick refits queue up and the stale ones are skipped.
+    // Declared after m_bootstrapPool, so it is destroyed first and waits for a running bootstrap while that pool
+    // still exists
+    QThreadPool m_bootstrapRunner;
+    // Bumped whenever the curve is refitted, a bootstrap of an older curve is skipped or dropped
+    std::atomic<quint64> m_standardCurveGeneration{0};
+    // "standard" runs add a point to the standard curve, "unknown" runs are quantified against it
+    QString m_sampleType;
+    // Quantities of the unknown experiments, shown on the Summary page
+    QString m_quantification;
+    // Runs naming the same group are replicates of one sample, empty when the run is in none
+    QString m_replicateGroup;
+    // Ct statistics of every group over all experiments, archived ones included
+    ReplicateGroups m_replicateGroups;
+    // Property signals sent at most once per frame, during a run and on load
+    UpdateCoalescer m_updates;
 
     Q_PROPERTY(int ledIntensity
         MEMBER m_ledIntensity
@@ -55,7 +120,39 @@ public:
         MEMBER m_intensityThreshold
         NOTIFY intensityThresholdChanged)
 
-    Q_PROPERTY(int cycleThreshold
+    Q_PROPERTY(bool autoThreshold
+        MEMBER m_autoThreshold
+        NOTIFY autoThresholdChanged)
+
+    Q_PROPERTY(double autoThresholdDelta
+        MEMBER m_autoThresholdDelta
+        NOTIFY autoThresholdDeltaChanged)
+
+    Q_PROPERTY(bool meltEnabled
+        MEMBER m_meltEnabled
+        NOTIFY meltEnabledChanged)
+
+    Q_PROPERTY(double meltingTemperature
+        MEMBER m_meltingTemperature
+        NOTIFY meltingTemperatureChanged)
+
+    Q_PROPERTY(bool earlyStop
+        MEMBER m_earlyStop
+        NOTIFY earlyStopChanged)
+
+    Q_PROPERTY(QString stopReason
+        MEMBER m_stopReason
+        NOTIFY stopReasonChanged)
+
+    Q_PROPERTY(double predictedCt
+        MEMBER m_predictedCt
+        NOTIFY predictedCtChanged)
+
+    Q_PROPERTY(double predictedCtUncertainty
+        MEMBER m_predictedCtUncertainty
+        NOTIFY predictedCtChanged)
+
+    Q_PROPERTY(double cycleThreshold
         MEMBER m_cycleThreshold
         NOTIFY cycleThresholdChanged)
 
@@ -91,91 +188,85 @@ public:
         MEMBER m_percentEfficiency
         NOTIFY percentEfficiencyChanged)
 
+    Q_PROPERTY(double slopeLower READ slopeLower NOTIFY standardCurveIntervalsChanged)
+    Q_PROPERTY(double slopeUpper READ slopeUpper NOTIFY standardCurveIntervalsChanged)
+    Q_PROPERTY(double interceptLower READ interceptLower NOTIFY standardCurveIntervalsChanged)
+    Q_PROPERTY(double interceptUpper READ interceptUpper NOTIFY standardCurveIntervalsChanged)
+    Q_PROPERTY(double efficiencyLower READ efficiencyLower NOTIFY standardCurveIntervalsChanged)
+    Q_PROPERTY(double efficiencyUpper READ efficiencyUpper NOTIFY standardCurveIntervalsChanged)
+
     Q_PROPERTY(QString summary
         MEMBER m_summary
         NOTIFY summaryChanged)
 
+    Q_PROPERTY(QString sampleType
+        MEMBER m_sampleType
+        NOTIFY sampleTypeChanged)
+
+    Q_PROPERTY(QString quantification
+        MEMBER m_quantification
+        NOTIFY quantificationChanged)
+
+    Q_PROPERTY(QString replicateGroup
+        MEMBER m_replicateGroup
+        NOTIFY replicateGroupChanged)
+
+    Q_PROPERTY(int replicateCount READ replicateCount NOTIFY replicateStatisticsChanged)
+    Q_PROPERTY(double replicateMeanCt READ replicateMeanCt NOTIFY replicateStatisticsChanged)
+    Q_PROPERTY(double replicateSd READ replicateSd NOTIFY replicateStatisticsChanged)
+    Q_PROPERTY(double replicateCv READ replicateCv NOTIFY replicateStatisticsChanged)
+    Q_PROPERTY(QString replicateSummary READ replicateSummary NOTIFY replicateStatisticsChanged)
+
     void updateLedIntensity();
     void updateMaxCycle();
     void updateIntensityThreshold();
+    void updateAutoThreshold();
+    void updateAutoThresholdDelta();
+    void updateMeltEnabled();
+    void updateMeltCurve();
+    void updateEarlyStop();
+    void updateStopReason();
     void updateCycleThreshold();
     void updateConcentrationCoefficient();
     void updateConcentrationMultiplier();
+    void updateSampleType();
+    void updateReplicateGroup();
+    // Moves the current run to its group with its current Ct and concentration
+    void updateReplicateStatistics();
+    // Every experiment's group from its parsed node or its archive index entry
+    void rebuildReplicateGroups();
+    // Summary of any experiment without loading its samples, the current one from its members
+    ExperimentMetadata metadataOf(const QString& experimentName) const;
+    // Replaces the standard curve with the given points and refits it
+    void setStandardCurve(const QList<QPair<double, double>>& points, const RegressionAccumulator& regression);
     void updateXYStandardCurve();
     void createExperimentFromTemplate(const QString& newName);
+    // Template experiment named experimentName, a null node when the template cannot be read
+    fkyaml::node readTemplate(const QString& experimentName);
+    // Make sure an archived experiment is decompressed into m_experiments before use
+    void ensureExperimentLoaded(const QString& experimentName);
+    // Baseline of the first sampleCount readings, sets the threshold when it is automatic
+    void updateBaseline(int sampleCount);
 
 public:
     DataManager() = default;
-    DataManager(QMap<QString, fkyaml::node>& experiments);
+    DataManager(QMap<QString, fkyaml::node>& experiments, QSharedPointer<ExperimentArchive> archive = nullptr);
     QList<float>& getIntensityValuesList();
-    QList<QPair<double, int>>& getXyLogStandardCurve();
+    QList<QPair<double, double>>& getXyLogStandardCurve();
     QList<QString>& getExperimentNames();
     void save_data();
     QString getCurrTimeStampStr();
-    /*
-     * Math Representation:
-     *
-     * Σ( (x_i - x̄) * (y_i - ȳ) )
-     * Slope (m) = --------------------------
-     * Σ( (x_i - x̄)² )
-     *
-     * Intercept (b) = ȳ - (m * x̄)
-     *
-     * --------------------------------------------------------------------------------------
-     * Variables:
-     * x̄ (x_bar) = Mean of X
-     * ȳ (y_bar) = Mean of Y
-     * Σ         = Summation loop
-     *
-     * Why use formula this?
-     * It prevents "Catastrophic Cancellation". By subtracting the mean first,
-     * we calculate using small "delta" values rather than massive raw totals.
-     * Read: What Every Computer Scientist Should Know About Floating-Point Arithmetic
-     * ======================================================================================
-     */
-    std::tuple<double, double, double>
-    simpleLinearRegression(const std::vector<double>& x, const std::vector<double>& y);
-
-    /*
-     * Math Representation:
-     *
-     * Efficiency (%) = ( 10^(-1 / Slope) - 1 ) * 100
-     *
-     * --------------------------------------------------------------------------------------
-     * Derivation Logic:
-     * 1. Ideally, PCR product doubles every cycle: N = N0 * 2^Ct
-     * 2. In log-log space, this doubling creates a theoretical slope of:
-     * m = -1 / log10(2) ≈ -3.3219
-     * 3. We reverse this to find the actual amplification factor:
-     * Factor = 10^(-1 / Slope)
-     * (e.g., Factor 2.0 = 100% efficient, Factor 1.9 = 90% efficient)
-     *
-     * --------------------------------------------------------------------------------------
-     * 1. Ideal Efficiency (100%):
-     * - A slope of -3.322 means that the PCR has an efficiency of 1, or 100%.
-     * - The amount of PCR product doubles during each cycle.
-     *
-     * 2. Low Efficiency (< 100%):
-     * - A slope of less than -3.322 (e.g., -3.8) indicates a PCR efficiency < 1.
-     * - Generally, most amplification reactions do not reach 100% efficiency due
-     * to experimental limitations.
-     *
-     * 3. High Efficiency (> 100%):
-     * - A slope greater than -3.322 (e.g., -3.0) indicates a PCR efficiency that
-     * appears to be greater than 100%.
-     * - This can occur when values are measured in the nonlinear phase of the
-     * reaction, or it can indicate the presence of inhibitors in the reaction.
-     *
-     * Source: https://www.qiagen.com/us/knowledge-and-support/knowledge-hub/bench-guide/pcr/commonly-used-terms-in-pcr/commonly-used-terms-in-pcr
-     * --------------------------------------------------------------------------------------
-     * Edge Case Safety:
-     * - If Slope is 0 (flat line): Efficiency approaches Infinity (Undefined).
-     * - If Slope is positive: Input data is likely inverted or garbage.
-     * ======================================================================================
-     */
-    double calculatePCREfficiency(double slope);
+    // Reliability verdict shown on the Summary page for a fitted standard curve
+    static QString standardCurveSummary(int pointCount, double rSquared);
+
 
     void setCycleThreshold();
+    // Log concentration and Ct of the current run, the point it adds to the curve as a standard
+    QPair<double, double> runPoint() const;
+    // Inserts at its place in the log concentration order, does not refit
+    void insertStandardCurvePoint(const QPair<double, double>& point);
+    // Index of a point on the curve that matches point, -1 when there is none
+    int standardCurvePointIndex(const QPair<double, double>& point) const;
     int getInitialLedIntensityValue();
     void setInitialLedIntensityValue(int ledIntensityValue);
     void removeExperiment(const QString experimentName);
@@ -188,18 +279,52 @@ public slots:
     Q_INVOKABLE void loadCurrentExperiment();
 
     void calculateStandardCurve();
+    // 95% intervals of the fitted curve on a worker thread, published by standardCurveIntervalsChanged
+    void startStandardCurveBootstrap();
+    // Exclude a point (e.g. an outlier) from the standard curve
+    Q_INVOKABLE void removeStandardCurvePoint(int index);
+    // Threshold from the baseline of the whole current curve, when autoThreshold is set
+    Q_INVOKABLE void estimateBaseline();
+    // Starting quantity of every unknown experiment from the current standard curve
+    Q_INVOKABLE void quantifyUnknowns();
+    // Standard curve with one point per replicate group of standards, at its mean Ct
+    Q_INVOKABLE void useReplicateMeans();
+    // Standard curve with one point per standard run among the given experiments, active or archived
+    Q_INVOKABLE void buildStandardCurve(const QStringList& experimentNames);
 
     void resetIntensityValues();
     void resetStandardCurveData();
 
     Q_INVOKABLE float getIntensityValueByIndex(int index);
     void addSensorReading(float lux);
+    void setStopReason(const QString& stopReason);
+    void resetMeltCurve();
+    void addMeltSample(float temperature, float lux);
+    // Peaks and Tm of the ramp so far, stored in the current experiment
+    void finishMeltCurve();
     void setIntensityValuesSize(int size);
     Q_INVOKABLE int getIntensityValuesSize() const;
     Q_INVOKABLE int getStandardCurveDataSize() const;
 
+    double slopeLower() const;
+    double slopeUpper() const;
+    double interceptLower() const;
+    double interceptUpper() const;
+    double efficiencyLower() const;
+    double efficiencyUpper() const;
+
+    // Statistics of the current run's replicate group
+    int replicateCount() const;
+    double replicateMeanCt() const;
+    double replicateSd() const;
+    double replicateCv() const;
+    // One line per group, shown on the Summary page
+    QString replicateSummary() const;
+
     Q_INVOKABLE float getConcentrationMultiplier() const;
     Q_INVOKABLE void setConcentrationMultiplier(float multiplier);
+    // Also moves the point of a finished run off the standard curve for "unknown", back on for "standard"
+    Q_INVOKABLE void setSampleType(const QString& sampleType);
 
     Q_INVOKABLE int getCurrentIntensityValuesIndex() const;
     Q_INVOKABLE void updateCurrentExperimentName(QString& currentExperimentName);
@@ -210,12 +335,30 @@ private slots:
 
 signals:
     void intensityValuesUpdated(int index, float value);
+    // Every reading was cleared at once, before a new run
+    void intensityValuesReset();
+    // The whole standard curve was replaced, e.g. on load
     void xyLogStandardCurveUpdated();
+    // A single point was inserted at or removed from index
+    void standardCurvePointInserted(int index);
+    void standardCurvePointRemoved(int index);
+    // Slope and intercept were refitted
+    void standardCurveFitChanged();
     void currentIntensityValuesIndexChanged(int newIndex);
     void maxCycleChanged();
 
     void ledIntensityChanged();
     void intensityThresholdChanged();
+    void autoThresholdChanged();
+    void autoThresholdDeltaChanged();
+    void meltEnabledChanged();
+    void meltingTemperatureChanged();
+    void meltCurveUpdated();
+    void earlyStopChanged();
+    void stopReasonChanged();
+    void predictedCtChanged();
+    // Every well is past Ct and flat, only emitted when earlyStop is set
+    void plateauReached();
     void cycleThresholdChanged();
     void currentExperimentNameChanged();
 
@@ -227,5 +370,13 @@ signals:
     void slopeChanged();
     void percentEfficiencyChanged();
     void summaryChanged();
+    void standardCurveIntervalsChanged();
+    void sampleTypeChanged();
+    void quantificationChanged();
+    void replicateGroupChanged();
+    void replicateStatisticsChanged();
     void standardCurveBoundsChanged();
+    // The file of an experiment was written or deleted, full names with ".yml"
+    void experimentSaved(const QString& experimentName);
+    void experimentRemoved(const QString& experimentName);
 };
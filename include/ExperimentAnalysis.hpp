@@ -0,0 +1,89 @@
+#pragma once
+
+#include "fkYAML.hpp"
+#include "BaselineEstimator.hpp"
+#include "CurveFitter.hpp"
+
+#include <QList>
+
+struct AnalysisSettings
+{
+    // Manual threshold in raw lux, not used when autoThreshold is set
+    double intensityThreshold{0.0};
+    bool autoThreshold{false};
+    bool fitCurve{true};
+    CurveFitter::Model model{CurveFitter::Model::FiveParameter};
+};
+
+struct AnalysisResult
+{
+    // The threshold actually used, picked from the baseline noise in automatic mode
+    double intensityThreshold{0.0};
+    // -1 when the threshold is never reached
+    double cycleThreshold{-1.0};
+    BaselineEstimate baseline;
+    CurveFit curveFit;
+};
+
+/**
+ * Analysis of one amplification curve, shared by DataManager and gwi-cli.
+ *
+ * Only depends on QtCore and the analysis classes, so it can run on worker
+ * threads and outside of the GUI.
+ */
+class ExperimentAnalysis
+{
+public:
+    static AnalysisResult analyze(const QList<float>& intensityValues, const AnalysisSettings& settings);
+
+    // Settings and readings saved in an experiment file
+    static AnalysisSettings settingsOf(const fkyaml::node& root);
+    static QList<float> intensityValuesOf(const fkyaml::node& root);
+    // Writes threshold, Ct and curve fit back into an experiment file
+    static void store(const AnalysisResult& result, const AnalysisSettings& settings, fkyaml::node& root);
+
+    // Numbers written as integers (older Ct values, hand edited files) read like floats
+    static double numberValue(const fkyaml::node& node);
+    // Float readings are stored as doubles in the YAML files. Widen them through their shortest
+    // float form so 244.58f is saved as 244.58 and not as 244.5800018310547
+    static double toStoredValue(float value);
+
+    /*
+     * Math Representation:
+     *
+     * Efficiency (%) = ( 10^(-1 / Slope) - 1 ) * 100
+     *
+     * --------------------------------------------------------------------------------------
+     * Derivation Logic:
+     * 1. Ideally, PCR product doubles every cycle: N = N0 * 2^Ct
+     * 2. In log-log space, this doubling creates a theoretical slope of:
+     * m = -1 / log10(2) ≈ -3.3219
+     * 3. We reverse this to find the actual amplification factor:
+     * Factor = 10^(-1 / Slope)
+     * (e.g., Factor 2.0 = 100% efficient, Factor 1.9 = 90% efficient)
+     *
+     * --------------------------------------------------------------------------------------
+     * 1. Ideal Efficiency (100%):
+     * - A slope of -3.322 means that the PCR has an efficiency of 1, or 100%.
+     * - The amount of PCR product doubles during each cycle.
+     *
+     * 2. Low Efficiency (< 100%):
+     * - A slope of less than -3.322 (e.g., -3.8) indicates a PCR efficiency < 1.
+     * - Generally, most amplification reactions do not reach 100% efficiency due
+     * to experimental limitations.
+     *
+     * 3. High Efficiency (> 100%):
+     * - A slope greater than -3.322 (e.g., -3.0) indicates a PCR efficiency that
+     * appears to be greater than 100%.
+     * - This can occur when values are measured in the nonlinear phase of the
+     * reaction, or it can indicate the presence of inhibitors in the reaction.
+     *
+     * Source: https://www.qiagen.com/us/knowledge-and-support/knowledge-hub/bench-guide/pcr/commonly-used-terms-in-pcr/commonly-used-terms-in-pcr
+     * --------------------------------------------------------------------------------------
+     * Edge Case Safety:
+     * - If Slope is 0 (flat line): Efficiency approaches Infinity (Undefined).
+     * - If Slope is positive: Input data is likely inverted or garbage.
+     * ======================================================================================
+     */
+    static double calculatePCREfficiency(double slope);
+};
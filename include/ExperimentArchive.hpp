@@ -0,0 +1,77 @@
+#pragma once
+
+#include "fkYAML.hpp"
+#include "ExperimentMetadata.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+// Metadata of an archived experiment, kept uncompressed in archive/index.yml
+struct ArchiveEntry
+{
+    QString experimentName;
+    QString lastSaved;
+    double rSquared{0.0};
+    double efficiency{0.0};
+    // Same as ExperimentMetadata, replicate statistics never decompress the sample data
+    QString replicateGroup;
+    QString sampleType{"standard"};
+    double cycleThreshold{-1.0};
+    double concentration{0.0};
+    qint64 originalSize{0};
+    qint64 compressedSize{0};
+};
+
+struct ArchiveReport
+{
+    int experimentsArchived{0};
+    qint64 bytesBefore{0};
+    qint64 bytesAfter{0};
+};
+
+/**
+ * Archive tier for experiments that have not been opened for a while.
+ *
+ * Stale experiments/<name>.yml files are zlib compressed (qCompress) into
+ * experiments/archive/<name>.z and removed from the active folder, while their
+ * summary stays readable in archive/index.yml. An archived experiment is
+ * decompressed back into the active folder the first time it is opened.
+ */
+class ExperimentArchive
+{
+public:
+    explicit ExperimentArchive(const QDir& experimentsDir);
+
+    // Compress every active experiment not opened for the given number of days
+    ArchiveReport archiveStale(int days);
+
+    bool contains(const QString& experimentName) const;
+    QStringList archivedNames() const;
+    const QMap<QString, ArchiveEntry>& entries() const;
+    // Summary of an archived experiment from the index, nothing is decompressed
+    ExperimentMetadata metadata(const QString& experimentName) const;
+
+    // Decompress an archived experiment into the active folder and parse it
+    bool restore(const QString& experimentName, fkyaml::node& experiment);
+    void markOpened(const QString& experimentName);
+    void remove(const QString& experimentName);
+    // Decompressed file content, empty when it cannot be read.
+    // Only touches the archive file, so it may run on a worker thread
+    QByteArray readArchived(const QString& experimentName) const;
+
+private:
+    void loadIndex();
+    // Fills in keys that an index written by an older version does not have
+    void completeIndex(const QStringList& experimentNames);
+    void saveIndex();
+    QString archivePath(const QString& experimentName) const;
+
+    QDir m_experimentsDir;
+    QDir m_archiveDir;
+    // experiment names or keys always have ".yml", like DataManager::m_experiments
+    QMap<QString, ArchiveEntry> m_entries;
+    QMap<QString, QDateTime> m_lastOpened;
+};
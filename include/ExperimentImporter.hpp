@@ -0,0 +1,96 @@
+#pragma once
+
+#include "fkYAML.hpp"
+#include "CurveFitter.hpp"
+
+#include <QDir>
+#include <QList>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <functional>
+
+// One amplification reaction read from a foreign cycler export
+struct ImportedRun
+{
+    QString name;
+    QList<float> intensityValues;
+    // Starting quantity of a standard, 0 for unknowns / not given
+    double quantity{0.0};
+};
+
+struct ImportReport
+{
+    int reactionsRead{0};
+    int experimentsWritten{0};
+    int standardCurvePoints{0};
+    double slope{0.0};
+    double yIntercept{0.0};
+    double rSquared{0.0};
+    double percentEfficiency{0.0};
+    QStringList writtenFiles;
+    QStringList warnings;
+
+    QString toString() const;
+};
+
+/**
+ * Converts RDML (uncompressed XML) and CSV amplification exports into
+ * experiment files that follow templates/empty_experiment.yml.
+ *
+ * The source file is streamed twice and never held in memory as a whole:
+ *  1. collect the Ct / quantity of every standard and fit the standard curve,
+ *  2. fit the sigmoid of every reaction, map it onto the experiment schema
+ *     together with the fitted standard curve and write the files in parallel,
+ *     one bounded batch at a time.
+ *
+ * Runs that would share a file name get a "_2", "_3", ... suffix. Existing
+ * experiments, active or archived, are never overwritten.
+ *
+ * CSV layout (',', ';' or tab separated, one reaction per line):
+ *   name,quantity,1,2,3,...        <- header, cycle columns are numbered
+ *   A1,1e5,0.12,0.13,0.15,...
+ */
+class ExperimentImporter
+{
+public:
+    ExperimentImporter(const QDir& experimentsDir, const fkyaml::node& templateNode);
+
+    ImportReport importFile(const QString& path);
+    void setBatchSize(int batchSize);
+
+private:
+    using RunCallback = std::function<void(ImportedRun&&)>;
+
+    bool streamRuns(const QString& path, const RunCallback& onRun, ImportReport& report);
+    bool streamRdml(const QString& path, const RunCallback& onRun, ImportReport& report);
+    bool streamCsv(const QString& path, const RunCallback& onRun, ImportReport& report);
+
+    bool validateRun(const ImportedRun& run, ImportReport& report) const;
+    void flushBatch(QList<ImportedRun>& batch, ImportReport& report);
+    // File name for a run, renamed when an earlier run of the import has it, empty when it exists on disk
+    QString reserveFileName(const QString& runName, ImportReport& report);
+    void writeExperiment(const ImportedRun& run, const CurveFit& curveFit, const QString& fileName,
+                         ImportReport& report);
+    static QString experimentFileName(const QString& runName);
+
+    QDir m_experimentsDir;
+    fkyaml::node m_template;
+    double m_intensityThreshold;
+    int m_batchSize;
+
+    // Fitted standard curve shared by every written experiment
+    QList<QPair<double, double>> m_xyLogStandardCurve;
+    QString m_summary;
+
+    // Active and archived experiments when the import started
+    QSet<QString> m_existingNames;
+    // File names given to the runs of the current import
+    QSet<QString> m_importedNames;
+
+    QThreadPool m_writerPool;
+    QMutex m_reportMutex;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "fkYAML.hpp"
+
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+// Summary of an experiment, enough to list it without loading its samples
+struct ExperimentMetadata
+{
+    QString experimentName;
+    QString lastSaved;
+    double rSquared{0.0};
+    double efficiency{0.0};
+    // Run result and replicate grouping, enough to aggregate Ct values across experiments
+    QString replicateGroup;
+    QString sampleType{"standard"};
+    double cycleThreshold{-1.0};
+    // concentration_coefficient × concentration_multiplier
+    double concentration{0.0};
+};
+
+/**
+ * Reads top-level keys of an experiment file with fkyaml::event_reader.
+ *
+ * Unlike fkyaml::node::deserialize no node is built for the samples: values of
+ * keys nobody asked for (light_sensor_data, standard_curve_points) are skipped
+ * and reading stops as soon as every requested key has been seen.
+ * Errors are reported with fkyaml::exception, like a full deserialize.
+ */
+class ExperimentMetadataReader
+{
+public:
+    // Scalar values of the requested keys, keys missing in the file are left out
+    static QMap<QString, fkyaml::node> readKeys(const QByteArray& content, const QStringList& keys);
+    static ExperimentMetadata read(const QByteArray& content);
+    // light_sensor_data alone, every other key is skipped
+    static QList<float> readIntensityValues(const QByteArray& content);
+    // Same summary from an experiment that is already parsed
+    static ExperimentMetadata fromNode(const fkyaml::node& root);
+};
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QHash>
 #include <QString>
 #include <QList>
+#include <QSet>
 #include <QSharedPointer>
 
 #include "DataManager.hpp"
+#include "ExperimentMetadata.hpp"
 
 class ExperimentModel : public QAbstractListModel
 {
@@ -25,13 +28,35 @@ public:
     Q_INVOKABLE void addEntry(const QString &name);
     Q_INVOKABLE void removeEntry(int index);
     Q_INVOKABLE void loadExperiment(int index);
+    // Experiments picked for a standard curve across experiments
+    Q_INVOKABLE void setSelected(int index, bool selected);
+    Q_INVOKABLE int selectedCount() const;
+    // Standard curve from the selected experiments, from their metadata only
+    Q_INVOKABLE void buildStandardCurve();
+
+    // Full name, with ".yml"
+    QString nameAt(int row) const;
+    // Read on first use from the parsed node or the archive index, the samples are never parsed
+    ExperimentMetadata metadataAt(int row) const;
+
+    enum ExperimentRoles {
+        RealFileNameRole = Qt::UserRole + 1,
+        SelectedRole,
+        LastSavedRole,
+        RSquaredRole,
+        EfficiencyRole
+    };
+
+private slots:
+    void onExperimentSaved(const QString &experimentName);
 
 private:
     // We store a pointer to the list inside DataManager
     QList<QString> *m_dataSource;
     QSharedPointer<DataManager> m_dataManager;
-
-    enum ExperimentRoles {
-        RealFileNameRole = Qt::UserRole + 1
-    };
+    // Full names, with ".yml"
+    QSet<QString> m_selectedNames;
+    // Same names as m_dataSource, for duplicate checks at any list size
+    QSet<QString> m_nameIndex;
+    mutable QHash<QString, ExperimentMetadata> m_metadataCache;
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "AmplificationCurveItem.hpp"
+#include "DataManager.hpp"
+#include "ExperimentArchive.hpp"
+#include "SampleCache.hpp"
+
+#include <QColor>
+#include <QDir>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
+
+// Experiments pinned to the amplification plot, drawn over the current one
+class ExperimentOverlay : public QObject
+{
+    Q_OBJECT
+
+    // Full names, with ".yml", in the order they were pinned
+    Q_PROPERTY(QStringList pinnedNames READ pinnedNames NOTIFY pinnedChanged)
+    Q_PROPERTY(int pinnedCount READ pinnedCount NOTIFY pinnedChanged)
+
+public:
+    // One color each, so no more than that many are pinned
+    static constexpr int MAX_PINNED = 8;
+
+    ExperimentOverlay(QSharedPointer<DataManager> dataManager, QSharedPointer<ExperimentArchive> archive,
+                      const QDir& experimentsDir, QObject* parent = nullptr);
+
+    QStringList pinnedNames() const;
+    int pinnedCount() const;
+
+    Q_INVOKABLE void pin(const QString& experimentName);
+    Q_INVOKABLE void pinCurrent();
+    Q_INVOKABLE void unpin(const QString& experimentName);
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE bool isPinned(const QString& experimentName) const;
+    Q_INVOKABLE QColor colorAt(int index) const;
+
+    // Pinned experiments whose readings are loaded, in pin order
+    QList<PlotCurve> curves();
+
+signals:
+    void pinnedChanged();
+    void curvesChanged();
+
+private slots:
+    void onSamplesLoaded(const QString& experimentName);
+    void onExperimentSaved(const QString& experimentName);
+    void onExperimentRemoved(const QString& experimentName);
+
+private:
+    QSharedPointer<DataManager> m_dataManager;
+    SampleCache m_cache;
+    QStringList m_pinnedNames;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ExperimentModel.hpp"
+
+#include <QList>
+#include <QSortFilterProxyModel>
+#include <QString>
+
+#include <vector>
+
+/**
+ * ExperimentModel sorted by name, date, R² or efficiency and filtered by name.
+ *
+ * Sort and filter keys are kept per source row, so lessThan() and
+ * filterAcceptsRow() compare plain values instead of going through data()
+ * and QVariant for every comparison. Names are lowercased once, metadata keys
+ * are only read, through ExperimentModel's metadata cache, while the list is
+ * sorted by them.
+ *
+ * --------------------------------------------------------------------------------------
+ * Filtering is a case-insensitive substring match. When the new text contains
+ * the previous one, as it does while the user types, only the rows that
+ * matched before can still match, and only those are tested again.
+ * ======================================================================================
+ */
+class ExperimentProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterTextChanged)
+    Q_PROPERTY(SortKey sortKey READ sortKey WRITE setSortKey NOTIFY sortKeyChanged)
+    Q_PROPERTY(bool descending READ descending WRITE setDescending NOTIFY descendingChanged)
+
+public:
+    enum SortKey {
+        Name,
+        LastSaved,
+        RSquared,
+        Efficiency
+    };
+    Q_ENUM(SortKey)
+
+    explicit ExperimentProxyModel(ExperimentModel *experimentModel, QObject *parent = nullptr);
+
+    QString filterText() const;
+    void setFilterText(const QString &filterText);
+    SortKey sortKey() const;
+    void setSortKey(SortKey sortKey);
+    bool descending() const;
+    void setDescending(bool descending);
+
+    // Rows of ExperimentModel and back, -1 when there is none
+    Q_INVOKABLE int sourceRow(int proxyRow) const;
+    Q_INVOKABLE int proxyRow(int sourceRow) const;
+
+signals:
+    void filterTextChanged();
+    void sortKeyChanged();
+    void descendingChanged();
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+private:
+    struct Key
+    {
+        // Lowercased, without ".yml"
+        QString name;
+        // Date for LastSaved, empty otherwise
+        QString text;
+        // R² or efficiency, 0 otherwise
+        double number{0.0};
+    };
+
+    Key makeKey(int sourceRow) const;
+    bool matches(const Key &key) const;
+    void rebuildKeys();
+    void updateSortKeys(int first, int last);
+
+    void onRowsInserted(const QModelIndex &parent, int first, int last);
+    void onRowsRemoved(const QModelIndex &parent, int first, int last);
+    void onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles);
+
+    ExperimentModel *m_experimentModel;
+    QString m_filterText;
+    // Lowercased m_filterText
+    QString m_needle;
+    SortKey m_sortKey{Name};
+    bool m_descending{false};
+    // Per source row
+    QList<Key> m_keys;
+    std::vector<char> m_accepted;
+};
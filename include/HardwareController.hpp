@@ -2,6 +2,7 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QElapsedTimer>
 //#include <QMutex> // Currently unused
 
 class HardwareController : public QObject {
@@ -22,6 +23,10 @@ class HardwareController : public QObject {
 
     // -- Threading
     QTimer* m_sensorTimer;
+
+    // -- Melt ramp, sampled far denser than the amplification cycles
+    QTimer* m_meltTimer;
+    QElapsedTimer m_meltClock;
     //QMutex m_hardwareMutex;   // Currently unused
     bool m_isInitialized;
 
@@ -43,6 +48,12 @@ class HardwareController : public QObject {
 #endif
         
 public:
+    // Nominal ramp setpoint: 65 -> 95 °C at 0.2 °C/s, one sample every 100 ms (0.02 °C)
+    static constexpr float MELT_START_TEMPERATURE = 65.0f;
+    static constexpr float MELT_END_TEMPERATURE = 95.0f;
+    static constexpr float MELT_RAMP_RATE = 0.2f;
+    static constexpr int MELT_SAMPLE_INTERVAL_MS = 100;
+
     explicit HardwareController(uint8_t sensorAddr = 0x23, int adapter = 1, int ledPin = 18, QObject* parent = nullptr);
     ~HardwareController();
 
@@ -61,18 +72,28 @@ public slots:
     void setLEDIntensity(int intensity);
     void startSensorReading();
     void stopSensorReading();
+    // Ends the amplification cycles before the last one, like reaching it does
+    void finishAmplification();
     void performSensorReading();
+    void startMeltRamp();
+    void stopMeltRamp();
+    void performMeltReading();
 
 private slots:
 #ifdef HAVE_WIRINGPI
     float readLuxFromSensor();
 #endif
     void onSensorTimer();
+    void onMeltTimer();
 
 signals:
     void hardwareInitialized(bool success);
     void ledIntensityChanged(int intensity);
     void sensorDataReady(float lux);
+    // Emitted once the last amplification cycle has been read
+    void amplificationFinished();
+    void meltSampleReady(float temperature, float lux);
+    void meltRampFinished();
 #ifdef HAVE_WIRINGPI
     void errorOccurred(const QString& error);
 #endif
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "fkYAML.hpp"
+
+#include <QList>
+
+#include <vector>
+
+struct MeltPeak
+{
+    // Parabola vertex between samples, °C
+    double temperature{0.0};
+    // -dF/dT at that temperature, lux/°C
+    double height{0.0};
+};
+
+struct MeltCurve
+{
+    QList<float> temperatures;
+    QList<float> fluorescence;
+    // -dF/dT per sample, NaN within half a filter window of either end
+    QList<float> derivative;
+    // Highest first
+    QList<MeltPeak> peaks;
+
+    // Temperature of the highest peak, 0 when there is none
+    double meltingTemperature() const;
+};
+
+/**
+ * Melt curve analysis: -dF/dT of the fluorescence during a temperature ramp and
+ * its peaks, the highest of which is the Tm of the product.
+ *
+ * Math Representation (Savitzky–Golay first derivative, quadratic, 2m + 1 taps):
+ *
+ * dF/di  = Σ k F(i + k) / Σ k²,  k = -m..m,  Σ k² = m (m + 1) (2m + 1) / 3
+ * dT/di  = (T(i + m) - T(i - m)) / 2m
+ * -dF/dT = -(dF/di) / (dT/di)
+ *
+ * Peaks are local maxima of -dF/dT, refined to the vertex of the parabola
+ * through the maximum and its two neighbours:
+ *
+ * offset = (y(i-1) - y(i+1)) / (2 (y(i-1) - 2 y(i) + y(i+1)))
+ *
+ * --------------------------------------------------------------------------------------
+ * The filter is a streaming kernel: add() takes one sample and, once 2m + 1 are
+ * in, gives the derivative of the sample m behind it, so the derivative follows
+ * the ramp m samples late instead of being computed after the run. A quadratic
+ * fit is used because its derivative taps are the same as the cubic one's and
+ * need no table. The temperature step comes from the samples themselves, a ramp
+ * that is not perfectly linear still gives the right scale.
+ *
+ * A peak counts when it stands at least 10% of the highest peak above the
+ * higher of the two valleys separating it from higher ground (its prominence),
+ * so ripples on the flank of the product peak are not reported while a primer
+ * dimer a few degrees lower is.
+ * ======================================================================================
+ */
+class MeltAnalyzer
+{
+public:
+    // ±0.3 °C at the 0.02 °C per sample of HardwareController's ramp
+    static constexpr int DEFAULT_HALF_WIDTH = 15;
+    static constexpr double MIN_PEAK_FRACTION = 0.1;
+
+    explicit MeltAnalyzer(int halfWidth = DEFAULT_HALF_WIDTH);
+
+    void reset();
+    // True when the derivative of an earlier sample became available
+    bool add(float temperature, float fluorescence);
+    // Finds the peaks of the derivative so far
+    void finish();
+    const MeltCurve& curve() const;
+
+    // Same as adding every sample and finishing
+    static MeltCurve analyze(const QList<float>& temperatures, const QList<float>& fluorescence,
+                             int halfWidth = DEFAULT_HALF_WIDTH);
+    static QList<MeltPeak> findPeaks(const QList<float>& temperatures, const QList<float>& derivative);
+
+    // "melt_curve" mapping of the experiment files, the derivative is recomputed on load
+    static fkyaml::node toNode(const MeltCurve& meltCurve);
+    static MeltCurve fromNode(const fkyaml::node& node);
+
+private:
+    int m_halfWidth;
+    // k / Σ k² for k = -m..m
+    std::vector<double> m_taps;
+    MeltCurve m_curve;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QList>
+
+#include <vector>
+
+/**
+ * Tells, cycle by cycle, when every well of a run has amplified and stopped
+ * rising, so the remaining cycles can be skipped.
+ *
+ * A well is done once it has crossed its threshold (it is past Ct) and then
+ *
+ * |F_k - F_(k-1)| / F_k < tolerance
+ *
+ * held for K consecutive cycles. The run has plateaued once every well is done.
+ *
+ * --------------------------------------------------------------------------------------
+ * Each well keeps its last reading, a crossed flag and a counter, so a cycle is
+ * O(wells) whatever the length of the run. Cycles before the crossing never
+ * count: a flat baseline is not a plateau. A reading that rises again by more
+ * than the tolerance restarts the count. With the defaults (2% for 3 cycles) the
+ * simulated curve (179, 183, 185, 186, 186.5 lx from cycle 26) stops at cycle 30.
+ * ======================================================================================
+ */
+class PlateauDetector
+{
+public:
+    static constexpr double DEFAULT_TOLERANCE = 0.02;
+    static constexpr int DEFAULT_CONSECUTIVE_CYCLES = 3;
+
+    explicit PlateauDetector(int wellCount = 1, double tolerance = DEFAULT_TOLERANCE,
+                             int consecutiveCycles = DEFAULT_CONSECUTIVE_CYCLES);
+
+    void reset();
+    // One reading per well for the next cycle, thresholds are in the same units as the readings
+    bool addCycle(const QList<float>& readings, const QList<double>& thresholds);
+    // Single well runs
+    bool addReading(float reading, double threshold);
+
+    int cycleCount() const;
+    bool plateaued() const;
+    // 1-based cycle at which the run plateaued, 0 while it has not
+    int plateauCycle() const;
+
+private:
+    struct WellState
+    {
+        float previous{0.0f};
+        bool crossed{false};
+        int flatCycles{0};
+    };
+
+    double m_tolerance;
+    int m_consecutiveCycles;
+    std::vector<WellState> m_wells;
+    int m_cycleCount{0};
+    int m_plateauCycle{0};
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DataManager.hpp"
+#include "UpdateCoalescer.hpp"
 
 #include <qqml.h>
 #include <QAbstractTableModel>
@@ -39,5 +40,23 @@ public:
 
 public slots:
     void onIntensityValuesUpdated(int index, float value);
+    // Brings the cached rows in line with DataManager through row inserts, removes and changes,
+    // the model is never reset
     void refresh();
+
+private:
+    // One table row per cycle, formatted once when its reading changes instead of on every repaint
+    struct Row
+    {
+        QString cycle;
+        QString intensity;
+        float value{0.0f};
+    };
+
+    static Row makeRow(int cycle, float value);
+    void onRowsChanged(int first, int last);
+
+    QList<Row> m_rows;
+    // Readings of one frame become one dataChanged per run of adjacent rows
+    UpdateCoalescer m_updates;
 };
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <tuple>
+
+/**
+ * Least squares line of the standard curve, updated one point at a time.
+ *
+ * Math Representation:
+ *
+ *             Σ( (x_i - x̄) * (y_i - ȳ) )
+ * Slope (m) = --------------------------
+ *                 Σ( (x_i - x̄)² )
+ *
+ * Intercept (b) = ȳ - (m * x̄)
+ *
+ * Welford, adding point k:
+ *
+ * x̄_k = x̄_(k-1) + (x_k - x̄_(k-1)) / k
+ * Sxx_k = Sxx_(k-1) + (x_k - x̄_(k-1)) * (x_k - x̄_k)
+ * Sxy_k = Sxy_(k-1) + (x_k - x̄_(k-1)) * (y_k - ȳ_k)
+ *
+ * Removing a point runs the same recurrences backwards, so both are O(1).
+ *
+ * --------------------------------------------------------------------------------------
+ * Why centered sums?
+ * They prevent "Catastrophic Cancellation". The sums stay centered on the
+ * running means, so they hold small "delta" values rather than massive raw
+ * totals, and the fit never touches raw Σx² or Σxy.
+ * Read: What Every Computer Scientist Should Know About Floating-Point Arithmetic
+ * ======================================================================================
+ */
+class RegressionAccumulator
+{
+public:
+    void add(double x, double y);
+    // The point must have been added before
+    void remove(double x, double y);
+    void reset();
+
+    int count() const;
+    double meanX() const;
+    double meanY() const;
+    double ssXX() const;
+    // Σ (y - ŷ)² of the fitted line, Syy - Sxy² / Sxx
+    double residualSumOfSquares() const;
+    // Slope, intercept and R². All 0 with fewer than 2 points or a single x, R² is 0 when every y is the same
+    std::tuple<double, double, double> fit() const;
+
+private:
+    int m_count{0};
+    double m_meanX{0.0};
+    double m_meanY{0.0};
+    double m_ssXX{0.0}; // Σ (x - x̄)²
+    double m_ssYY{0.0}; // Σ (y - ȳ)²
+    double m_ssXY{0.0}; // Σ (x - x̄)(y - ȳ)
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QString>
+
+// Ct statistics of the runs sharing one replicate group
+struct ReplicateStatistics
+{
+    int count{0};
+    // Runs of the group that are unknowns, a group with any is left out of the standard curve
+    int unknownCount{0};
+    // Runs of the group without a concentration, a group with any has no point on the standard curve either
+    int missingConcentrationCount{0};
+    double meanCycleThreshold{0.0};
+    // Σ (Ct - mean)², the standard deviation is taken from it
+    double ssCycleThreshold{0.0};
+    double meanLogConcentration{0.0};
+
+    // Sample standard deviation (n - 1), 0 for a single run
+    double standardDeviation() const;
+    // Coefficient of variation in percent
+    double coefficientOfVariation() const;
+};
+
+/**
+ * Replicate groups over all experiments: runs that name the same
+ * "replicate_group" are replicates of one sample, and their Ct values are
+ * summarized as mean, SD and CV.
+ *
+ * Math Representation (Welford, adding run k):
+ *
+ * mean_k = mean_(k-1) + (Ct_k - mean_(k-1)) / k
+ * S_k    = S_(k-1) + (Ct_k - mean_(k-1)) * (Ct_k - mean_k)
+ * SD     = √(S / (n - 1)),  CV = SD / mean * 100%
+ *
+ * Removing a run runs the same recurrences backwards, so both are O(1).
+ *
+ * --------------------------------------------------------------------------------------
+ * Every experiment remembers what it added, set() takes that back out before
+ * adding the new values, so a rerun, a changed group or a changed concentration
+ * moves the run without touching the other members. Only runs that crossed the
+ * threshold (Ct >= 0) are counted. groupMeans() gives one (log concentration,
+ * mean Ct) point per group of standards that all have a concentration, a standard curve over replicate means
+ * instead of over every single run.
+ * ======================================================================================
+ */
+class ReplicateGroups
+{
+public:
+    // Replaces whatever the experiment added before, an empty group only removes it.
+    // logConcentration is NaN for a run without a positive concentration
+    void set(const QString& experimentName, const QString& group, bool unknown,
+             double logConcentration, double cycleThreshold);
+    void remove(const QString& experimentName);
+    void clear();
+
+    // Group of an experiment, empty when it is in none
+    QString groupOf(const QString& experimentName) const;
+    // count is 0 for a group nobody is in
+    ReplicateStatistics statistics(const QString& group) const;
+    const QMap<QString, ReplicateStatistics>& groups() const;
+    // (log concentration, mean Ct) of every group of standards, sorted by log concentration
+    QList<QPair<double, double>> groupMeans() const;
+
+private:
+    struct Member
+    {
+        QString group;
+        bool unknown{false};
+        bool missingConcentration{false};
+        // 0 when missing, so it adds nothing to the group's mean
+        double logConcentration{0.0};
+        double cycleThreshold{0.0};
+    };
+
+    QHash<QString, Member> m_members;
+    QMap<QString, ReplicateStatistics> m_groups;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "RegressionAccumulator.hpp"
+
+#include <QList>
+#include <QPair>
+
+#include <utility>
+
+struct RobustFit
+{
+    double slope{0.0};
+    double intercept{0.0};
+    // Weighted R², the same as the plain R² when no point is down-weighted
+    double rSquared{0.0};
+    // Robust standard deviation of the residuals (Ct cycles)
+    double scale{0.0};
+
+    // One entry per point, in the order of the input
+    QList<double> weights;
+    QList<double> leaveOneOutRSquared;
+    QList<bool> outliers;
+
+    int outlierCount() const;
+};
+
+/**
+ * Standard curve fit that a single bad dilution cannot drag away.
+ *
+ * 1. Theil–Sen start: slope = median of the pairwise slopes, intercept = median
+ *    of y_i - slope * x_i, residual scale s = 1.4826 * median |r_i|.
+ * 2. Points further than 3 s from that line are flagged as outliers and get no
+ *    weight. Huber alone only bounds their pull, which is not enough for a bad
+ *    point at the end of the dilution series.
+ * 3. Huber IRLS over the other points: weighted least squares with
+ *
+ *      w_i = min(1, k s / |r_i|),  k = 1.345
+ *
+ *    repeated until the line stops moving. Points within k s of the line keep
+ *    their full weight, so clean data gives exactly the ordinary fit.
+ * 4. Leave-one-out: each point is removed from a copy of the ordinary fit's
+ *    RegressionAccumulator (an O(1) downdate), giving the R² the curve would
+ *    have without that point in O(n) overall.
+ *
+ * --------------------------------------------------------------------------------------
+ * Pairs with the same x (replicates of one dilution) have no slope and are
+ * skipped by Theil–Sen. s never goes below 0.1 cycles, about the replicate
+ * spread of a Ct, so a nearly perfect curve does not flag rounding noise.
+ * Theil–Sen is O(n²) in the number of points, which stays in the microseconds
+ * for the handful of dilutions a standard curve has.
+ * ======================================================================================
+ */
+class RobustRegression
+{
+public:
+    static constexpr double HUBER_K = 1.345;
+    static constexpr double OUTLIER_CUTOFF = 3.0;
+    static constexpr double MIN_SCALE = 0.1;
+
+    // Slope and intercept, {0, 0} when every x is the same
+    static std::pair<double, double> theilSen(const QList<QPair<double, double>>& points);
+    // Needs at least 3 points with different x, otherwise everything is 0
+    static RobustFit fit(const QList<QPair<double, double>>& points);
+    // Same, reusing an accumulator that already holds every point
+    static RobustFit fit(const QList<QPair<double, double>>& points, const RegressionAccumulator& ordinary);
+};
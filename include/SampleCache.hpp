@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <functional>
+
+/**
+ * Intensity readings of experiments other than the current one, shared read-only.
+ *
+ * A request for an experiment that is not cached loads it on a worker thread:
+ * the loader returns the file content and only light_sensor_data is read from
+ * it with the pull parser (ExperimentMetadataReader::readIntensityValues), the
+ * rest of the file never becomes a node. loaded() is emitted on the thread of
+ * the cache once the readings are in.
+ *
+ * --------------------------------------------------------------------------------------
+ * At most capacity experiments are kept and the least recently used one is
+ * evicted first. Readings are handed out as QSharedPointer<const QList<float>>,
+ * so a curve still drawn keeps its readings after eviction and nothing is
+ * copied. Going back to an experiment that is still cached costs no parse.
+ * ======================================================================================
+ */
+class SampleCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Samples = QSharedPointer<const QList<float>>;
+    // Content of an experiment file, empty when it cannot be read. Runs on a worker thread
+    using Loader = std::function<QByteArray(const QString& experimentName)>;
+
+    explicit SampleCache(Loader loader, int capacity = 32, QObject* parent = nullptr);
+    ~SampleCache() override;
+
+    // Readings of a cached experiment, null when not cached. Marks it as used
+    Samples find(const QString& experimentName);
+    // Loads in the background, unless cached or being loaded already
+    void request(const QString& experimentName);
+    // The file was saved or removed, the next request reads it again
+    void invalidate(const QString& experimentName);
+
+signals:
+    // Also emitted when the file could not be read, find() then stays null
+    void loaded(const QString& experimentName);
+
+private:
+    void onLoaded(const QString& experimentName, int generation, const Samples& samples);
+    void touch(const QString& experimentName);
+
+    Loader m_loader;
+    int m_capacity;
+    QHash<QString, Samples> m_samples;
+    // Least recently used first
+    QStringList m_recent;
+    QSet<QString> m_loading;
+    // Bumped by invalidate(), a load started before it is read again
+    QHash<QString, int> m_generations;
+    // Last, so that running loads finish before anything else is destroyed
+    QThreadPool m_pool;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QList>
+#include <QPair>
+#include <QThreadPool>
+
+#include <cstdint>
+
+struct ConfidenceInterval
+{
+    double lower{0.0};
+    double upper{0.0};
+
+    bool contains(double value) const;
+};
+
+struct StandardCurveIntervals
+{
+    bool valid{false};
+    int pointCount{0};
+    // Resamples that had at least two different x and could be fitted
+    int resamples{0};
+
+    // 95% bootstrap percentile intervals
+    ConfidenceInterval slope;
+    ConfidenceInterval intercept;
+    ConfidenceInterval efficiency;
+
+    // Jackknife standard errors
+    double slopeStandardError{0.0};
+    double interceptStandardError{0.0};
+};
+
+/**
+ * Confidence intervals of the standard curve line and its efficiency.
+ *
+ * Bootstrap (pairs): every resample draws n points with replacement. A draw is
+ * kept as a count per point, c_i, so the fit of a resample is a few weighted
+ * sums and no point is copied:
+ *
+ * Sc = Σ c_i,  Sx = Σ c_i x_i,  Sy = Σ c_i y_i,  Sxx = Σ c_i x_i²,  Sxy = Σ c_i x_i y_i
+ * slope = (Sc Sxy - Sx Sy) / (Sc Sxx - Sx²),  intercept = (Sy - slope Sx) / Sc
+ *
+ * Eight resamples are accumulated side by side, one lane each, so the sums
+ * vectorize across resamples without reassociating any of them (no fast-math).
+ * x and y are centered on their means first, so the sums stay small. The 2.5th
+ * and 97.5th percentiles of the resampled slope, intercept and efficiency are
+ * the 95% interval.
+ *
+ * Jackknife: θ_(i) is the fit without point i, a RegressionAccumulator downdate,
+ *
+ * SE = √((n - 1) / n * Σ (θ_(i) - θ̄)²)
+ *
+ * --------------------------------------------------------------------------------------
+ * Resamples are split into a fixed number of blocks, each with its own
+ * Xoshiro256 stream (the seed jumped once per block), and the blocks are spread
+ * over a QThreadPool. The result therefore only depends on the seed, never on
+ * the number of threads or the order they finish in.
+ * ======================================================================================
+ */
+class StandardCurveBootstrap
+{
+public:
+    static constexpr int DEFAULT_RESAMPLES = 10000;
+    static constexpr std::uint64_t DEFAULT_SEED = 0x67776925ULL;
+    static constexpr int BLOCKS = 16;
+
+    // Needs at least 3 points with different x, otherwise the result is not valid
+    static StandardCurveIntervals compute(const QList<QPair<double, double>>& points, QThreadPool& pool,
+                                          int resamples = DEFAULT_RESAMPLES, std::uint64_t seed = DEFAULT_SEED);
+};
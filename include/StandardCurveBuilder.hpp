@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ExperimentMetadata.hpp"
+#include "RegressionAccumulator.hpp"
+
+#include <QList>
+#include <QPair>
+
+struct StandardCurveBuild
+{
+    // (log concentration, Ct), sorted by log concentration
+    QList<QPair<double, double>> points;
+    // Least squares sums over points, ready for RobustRegression::fit
+    RegressionAccumulator regression;
+    // Runs that gave no point: unknowns, runs without a Ct and runs without a concentration
+    int skipped{0};
+};
+
+/**
+ * Standard curve over many experiments at once, one point per standard run.
+ *
+ * x = log10(concentration_coefficient × concentration_multiplier),  y = Ct
+ *
+ * --------------------------------------------------------------------------------------
+ * Only the metadata of every run is needed, the summary that
+ * ExperimentMetadataReader reads without building the samples or that the
+ * archive index keeps for compressed experiments, so no light_sensor_data is
+ * ever loaded. The points are collected and the regression sums accumulated in
+ * a single pass, then sorted once, instead of one sorted insert per run as
+ * DataManager::setCycleThreshold does while a dilution series is measured.
+ * ======================================================================================
+ */
+class StandardCurveBuilder
+{
+public:
+    static StandardCurveBuild build(const QList<ExperimentMetadata>& runs);
+};
@@ -5,6 +5,7 @@
 #include <qqml.h>
 #include <QAbstractTableModel>
 #include <QList>
+#include <QPointF>
 
 #include <QSharedPointer>
 #include <QDebug>
@@ -14,6 +15,11 @@ class StandardCurveModel : public QAbstractTableModel
     Q_OBJECT
     QML_ELEMENT
 
+    // Ends of the fitted line over the x range of the points, for the chart overlay
+    Q_PROPERTY(bool fitValid READ fitValid NOTIFY fitChanged)
+    Q_PROPERTY(QPointF fitStart READ fitStart NOTIFY fitChanged)
+    Q_PROPERTY(QPointF fitEnd READ fitEnd NOTIFY fitChanged)
+
     // Hold pointer to the data manager
     // to interact with light intensity data
     QSharedPointer<DataManager> m_dataManager;
@@ -34,9 +40,26 @@ public:
 
     QHash<int, QByteArray> roleNames() const override;
 
+    bool fitValid() const;
+    QPointF fitStart() const;
+    QPointF fitEnd() const;
+
 public slots:
+    // The whole curve was replaced, brought in line with row removes, changes and inserts
     void refreshModel();
 
 private slots:
-    void onStandardCurveUpdated(int index, float value);
+    void onPointInserted(int index);
+    void onPointRemoved(int index);
+    void onFitChanged();
+
+signals:
+    void fitChanged();
+
+private:
+    // Rows the view knows about, DataManager's list has already changed when it notifies
+    int m_rowCount{0};
+    bool m_fitValid{false};
+    QPointF m_fitStart;
+    QPointF m_fitEnd;
 };
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QList>
+#include <QMetaMethod>
+#include <QObject>
+#include <QPair>
+#include <QTimer>
+
+#include <functional>
+#include <tuple>
+#include <utility>
+
+/**
+ * Change notifications gathered between two frames and sent once.
+ *
+ * Changed rows are kept as sorted ranges, and overlapping or adjacent ranges
+ * are merged. A flush emits rowsChanged() once per merged range. A signal
+ * marked again before the flush is emitted only once, with the arguments of
+ * its last mark, and signals go out in the order they were first marked.
+ *
+ * --------------------------------------------------------------------------------------
+ * The first mark after a flush starts a single-shot timer of one 60 Hz frame
+ * (16 ms). QML bindings on a property are then re-evaluated at most once per
+ * frame, however many readings or property writes come in during it. Models
+ * that insert or remove rows call flush() first, so no pending range can point
+ * past the rows the view knows about.
+ * ======================================================================================
+ */
+class UpdateCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UpdateCoalescer(int intervalMs = 16, QObject* parent = nullptr);
+
+    // Rows first..last changed
+    void markRows(int first, int last);
+
+    // Emit sender's signal at the next flush, once, with the arguments of the last mark
+    template<typename Object, typename... Parameters, typename... Arguments>
+    void markSignal(Object* sender, void (Object::*signal)(Parameters...), Arguments&&... arguments)
+    {
+        const int methodIndex = QMetaMethod::fromSignal(signal).methodIndex();
+        markNotification(sender, methodIndex,
+                         [sender, signal, values = std::make_tuple(std::forward<Arguments>(arguments)...)]() {
+                             std::apply([sender, signal](const auto&... value) { (sender->*signal)(value...); }, values);
+                         });
+    }
+
+    // Sends everything pending now
+    void flush();
+
+signals:
+    void rowsChanged(int first, int last);
+
+private:
+    struct Notification
+    {
+        const QObject* sender;
+        int methodIndex;
+        std::function<void()> emitSignal;
+    };
+
+    void markNotification(const QObject* sender, int methodIndex, std::function<void()> emitSignal);
+    void schedule();
+
+    QTimer m_timer;
+    // Sorted, neither overlapping nor adjacent
+    QList<QPair<int, int>> m_rows;
+    // In the order of their first mark
+    QList<Notification> m_notifications;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * xoshiro256** pseudo random generator (Blackman & Vigna), seeded through
+ * splitmix64 like the reference implementation.
+ *
+ * Four 64-bit words of state, a handful of shifts, rotates and xors per number,
+ * several times faster than std::mt19937_64 and small enough to keep one per
+ * thread. jump() advances the state by 2^128 numbers, so generators jumped
+ * 0, 1, 2, ... times from one seed give streams that never overlap.
+ * ======================================================================================
+ */
+class Xoshiro256
+{
+public:
+    explicit Xoshiro256(std::uint64_t seed)
+    {
+        for(auto& word : m_state)
+        {
+            seed += 0x9e3779b97f4a7c15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    std::uint64_t next()
+    {
+        const std::uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const std::uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, bound), Lemire's multiply-shift without the rejection step,
+    // its bias is below bound / 2^32 and irrelevant for resampling a few dozen points
+    std::uint32_t below(std::uint32_t bound)
+    {
+        return static_cast<std::uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    void jump()
+    {
+        static constexpr std::uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                                 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        std::uint64_t jumped[4] = {0, 0, 0, 0};
+        for(const std::uint64_t word : JUMP)
+        {
+            for(int bit = 0; bit < 64; ++bit)
+            {
+                if(word & (std::uint64_t{1} << bit))
+                {
+                    for(int i = 0; i < 4; ++i)
+                    {
+                        jumped[i] ^= m_state[i];
+                    }
+                }
+                next();
+            }
+        }
+        for(int i = 0; i < 4; ++i)
+        {
+            m_state[i] = jumped[i];
+        }
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t m_state[4];
+};
@@ -60,8 +60,23 @@
 
 #define FK_YAML_NAMESPACE_VERSION_CONCAT(major, minor, patch) FK_YAML_NAMESPACE_VERSION_CONCAT_IMPL(major, minor, patch)
 
+// Setting FK_YAML_NUMERIC_FAST_PATH to 0 builds the parser without the numeric fast path. That build gets its own
+// inline namespace, so gwi-bench can link both builds and compare them.
+#ifndef FK_YAML_NUMERIC_FAST_PATH
+#define FK_YAML_NUMERIC_FAST_PATH 1
+#endif
+
+#if FK_YAML_NUMERIC_FAST_PATH
 #define FK_YAML_NAMESPACE_VERSION                                                                                      \
     FK_YAML_NAMESPACE_VERSION_CONCAT(FK_YAML_MAJOR_VERSION, FK_YAML_MINOR_VERSION, FK_YAML_PATCH_VERSION)
+#else
+#define FK_YAML_NAMESPACE_VERSION_NO_FAST_PATH_CONCAT_IMPL(major, minor, patch)                                        \
+    v##major##_##minor##_##patch##_no_numeric_fast_path
+#define FK_YAML_NAMESPACE_VERSION_NO_FAST_PATH_CONCAT(major, minor, patch)                                             \
+    FK_YAML_NAMESPACE_VERSION_NO_FAST_PATH_CONCAT_IMPL(major, minor, patch)
+#define FK_YAML_NAMESPACE_VERSION                                                                                      \
+    FK_YAML_NAMESPACE_VERSION_NO_FAST_PATH_CONCAT(FK_YAML_MAJOR_VERSION, FK_YAML_MINOR_VERSION, FK_YAML_PATCH_VERSION)
+#endif
 
 #define FK_YAML_NAMESPACE_BEGIN                                                                                        \
     namespace fkyaml {                                                                                                 \
@@ -3546,6 +3561,47 @@ public:
         }
     }
 
+    /// @brief Skips a block node which starts on a following line without scanning its tokens.
+    /// @note
+    /// This function must be called in a block context right after the key separator of the key which owns the node.
+    /// Lines indented more than the key, and block sequence entries as indented as the key belong to the node.
+    /// @param key_indent The indentation of the key.
+    /// @return true if the node has been skipped, false if the node starts on the current line. (nothing is skipped)
+    bool skip_block_node(uint32_t key_indent) {
+        FK_YAML_ASSERT((m_state & flow_context_bit) == 0);
+
+        const char* p_cur = std::find_if_not(m_cur_itr, m_end_itr, [](char c) { return (c == ' ' || c == '\t'); });
+        if (p_cur != m_end_itr && *p_cur != '\n' && *p_cur != '#') {
+            return false;
+        }
+
+        const char* p_line_begin = std::find(p_cur, m_end_itr, '\n');
+        while (p_line_begin != m_end_itr) {
+            ++p_line_begin;
+            p_cur = std::find_if_not(p_line_begin, m_end_itr, [](char c) { return c == ' '; });
+            const auto indent = static_cast<uint32_t>(p_cur - p_line_begin);
+
+            bool is_node_line = indent > key_indent;
+            if (!is_node_line) {
+                // blank lines and comments do not end the node.
+                p_cur = std::find_if_not(p_cur, m_end_itr, [](char c) { return c == '\t'; });
+                is_node_line = p_cur == m_end_itr || *p_cur == '\n' || *p_cur == '#';
+            }
+            if (!is_node_line && indent == key_indent && *p_cur == '-') {
+                const char* p_next = p_cur + 1;
+                is_node_line = p_next == m_end_itr || *p_next == ' ' || *p_next == '\t' || *p_next == '\n';
+            }
+            if (!is_node_line) {
+                break;
+            }
+
+            p_line_begin = std::find(p_cur, m_end_itr, '\n');
+        }
+
+        m_cur_itr = p_line_begin;
+        return true;
+    }
+
 private:
     uint32_t get_current_indent_level(const char* p_line_end) {
         // get the beginning position of the current line.
@@ -4071,9 +4127,19 @@ private:
 
         // flow indicators are checked only within a flow context.
         const str_view filter = (m_state & flow_context_bit) ? "\t\n :{}[]," : "\t\n :";
-        std::size_t pos = sv.find_first_of(filter);
+
+        // Numeric scalars dominate typical data files. Their characters can neither end a plain scalar nor be
+        // control characters, so skip them without the generic per-character checks below.
+        std::size_t num_len = 0;
+#if FK_YAML_NUMERIC_FAST_PATH
+        while (num_len < sv.size() && is_numeric_char(sv[num_len])) {
+            ++num_len;
+        }
+#endif
+
+        std::size_t pos = sv.find_first_of(filter, num_len);
         if FK_YAML_UNLIKELY (pos == str_view::npos) {
-            check_scalar_content(sv);
+            check_scalar_content(sv.substr(num_len));
             m_cur_itr = m_end_itr;
             return sv;
         }
@@ -4168,11 +4234,37 @@ private:
         } while (pos != str_view::npos);
 
         str_view plain_scalar = sv.substr(0, pos);
-        check_scalar_content(plain_scalar);
+        check_scalar_content(plain_scalar.substr(num_len));
         m_cur_itr = plain_scalar.end();
         return plain_scalar;
     }
 
+    /// @brief Check if the given character can appear in a decimal number.
+    /// @param c A character to be checked.
+    /// @return true if the character is either a digit, a sign, a decimal point or an exponent mark.
+    static bool is_numeric_char(char c) noexcept {
+        switch (c) {
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+        case '+':
+        case '-':
+        case '.':
+        case 'e':
+        case 'E':
+            return true;
+        default:
+            return false;
+        }
+    }
+
     /// @brief Scan a block style string token either in the literal or folded style.
     /// @param base_indent The base indent level of the block scalar.
     /// @param indicated_indent The indicated indent level in the block scalar header. 0 means it's not indicated.
@@ -6145,6 +6237,15 @@ public:
             lex_type == lexical_token_t::DOUBLE_QUOTED_SCALAR);
         FK_YAML_ASSERT(tag_type != tag_t::SEQUENCE && tag_type != tag_t::MAPPING);
 
+#if FK_YAML_NUMERIC_FAST_PATH
+        if (lex_type == lexical_token_t::PLAIN_SCALAR && tag_type == tag_t::NONE) {
+            const node_type number_type = scan_plain_number(token);
+            if (number_type != node_type::STRING) {
+                return create_scalar_node(number_type, tag_type, token);
+            }
+        }
+#endif
+
         token = parse_flow_scalar_token(lex_type, token);
         const node_type value_type = decide_value_type(lex_type, tag_type, token);
         return create_scalar_node(value_type, tag_type, token);
@@ -6174,6 +6275,66 @@ public:
     }
 
 private:
+    /// @brief Fast path for untagged plain scalars in the common decimal forms (`-?[0-9]+(\.[0-9]+)?([eE][-+]?[0-9]+)?`).
+    /// @note Such scalars never need line folding nor escaping and their type is known once they have been classified,
+    /// so they can be converted directly without going through parse_plain_scalar() and scalar_scanner. Everything
+    /// else (signs, leading zeros, octal/hex, .inf/.nan...) is left to the generic path.
+    /// @param token Scalar contents.
+    /// @return node_type::INTEGER or node_type::FLOAT if the fast path applies, node_type::STRING otherwise.
+    static node_type scan_plain_number(str_view token) noexcept {
+        const char* p_cur = token.begin();
+        const char* p_end = token.end();
+
+        if (p_cur != p_end && *p_cur == '-') {
+            ++p_cur;
+        }
+
+        const char* p_digits = p_cur;
+        while (p_cur != p_end && is_digit(*p_cur)) {
+            ++p_cur;
+        }
+        const auto int_digits = static_cast<uint32_t>(p_cur - p_digits);
+        if (int_digits == 0 || (*p_digits == '0' && int_digits > 1)) {
+            return node_type::STRING;
+        }
+
+        node_type type = node_type::INTEGER;
+        if (p_cur != p_end && *p_cur == '.') {
+            const char* p_frac = ++p_cur;
+            while (p_cur != p_end && is_digit(*p_cur)) {
+                ++p_cur;
+            }
+            if (p_cur == p_frac) {
+                return node_type::STRING;
+            }
+            type = node_type::FLOAT;
+        }
+
+        if (p_cur != p_end && (*p_cur == 'e' || *p_cur == 'E')) {
+            ++p_cur;
+            if (p_cur != p_end && (*p_cur == '-' || *p_cur == '+')) {
+                ++p_cur;
+            }
+            const char* p_exp = p_cur;
+            while (p_cur != p_end && is_digit(*p_cur)) {
+                ++p_cur;
+            }
+            if (p_cur == p_exp) {
+                return node_type::STRING;
+            }
+            type = node_type::FLOAT;
+        }
+
+        return (p_cur == p_end) ? type : node_type::STRING;
+    }
+
+    /// @brief Check if the given character is a digit.
+    /// @param c A character to be checked.
+    /// @return true if the given character is a digit, false otherwise.
+    static bool is_digit(char c) noexcept {
+        return ('0' <= c && c <= '9');
+    }
+
     /// @brief Parses a token into a flow scalar contents.
     /// @param lex_type Lexical token type for the scalar.
     /// @param token Scalar contents.
@@ -7226,6 +7387,7 @@ private:
 
         basic_node_type root;
         mp_current_node = &root;
+        root.mp_meta = std::make_shared<doc_metainfo_type>();
         mp_meta = root.mp_meta;
 
         // parse directives first.
@@ -9903,6 +10065,553 @@ FK_YAML_DETAIL_NAMESPACE_END
 
 #endif /* FK_YAML_DETAIL_INPUT_INPUT_ADAPTER_HPP */
 
+// #include <fkYAML/event_reader.hpp>
+//  _______   __ __   __  _____   __  __  __
+// |   __| |_/  |  \_/  |/  _  \ /  \/  \|  |     fkYAML: A C++ header-only YAML library
+// |   __|  _  < \_   _/|  ___  |    _   |  |___  version 0.4.2
+// |__|  |_| \__|  |_|  |_|   |_|___||___|______| https://github.com/fktn-k/fkYAML
+//
+// SPDX-FileCopyrightText: 2023-2025 Kensuke Fukutani <fktn.dev@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef FK_YAML_EVENT_READER_HPP
+#define FK_YAML_EVENT_READER_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// #include <fkYAML/detail/macros/define_macros.hpp>
+
+// #include <fkYAML/detail/assert.hpp>
+
+// #include <fkYAML/detail/input/input_adapter.hpp>
+
+// #include <fkYAML/detail/input/lexical_analyzer.hpp>
+
+// #include <fkYAML/detail/input/scalar_parser.hpp>
+
+// #include <fkYAML/detail/input/tag_t.hpp>
+
+// #include <fkYAML/detail/meta/node_traits.hpp>
+
+// #include <fkYAML/detail/str_view.hpp>
+
+// #include <fkYAML/detail/types/lexical_token_t.hpp>
+
+// #include <fkYAML/exception.hpp>
+
+
+FK_YAML_NAMESPACE_BEGIN
+
+/// @brief Definition of events reported by basic_event_reader.
+enum class event_type : std::uint8_t {
+    MAPPING_BEGIN,   //!< the beginning of a mapping.
+    MAPPING_END,     //!< the end of a mapping.
+    SEQUENCE_BEGIN,  //!< the beginning of a sequence.
+    SEQUENCE_END,    //!< the end of a sequence.
+    KEY,             //!< a scalar mapping key. use raw() or value() to get its contents.
+    SCALAR,          //!< a scalar value. use raw() or value() to get its contents.
+    END_OF_DOCUMENT, //!< the end of the document. reported again on every further call.
+};
+
+/// @brief A pull parser which reports the first YAML document in the input as a series of events.
+/// @note
+/// No node is created while reading. Scalars are converted only when value() is called and unwanted subtrees can be
+/// discarded with skip(), so callers interested in a few keys can stop as soon as they have them.
+/// Anchors, aliases, tags and explicit block mapping keys are not supported and cause a parse_error to be thrown.
+/// Use basic_node::deserialize() for such documents.
+/// @tparam BasicNodeType A basic_node template instance type used to convert scalars.
+template <typename BasicNodeType>
+class basic_event_reader {
+    static_assert(detail::is_basic_node<BasicNodeType>::value, "basic_event_reader only accepts basic_node<...>");
+
+public:
+    /** A type for YAML nodes returned by value(). */
+    using basic_node_type = BasicNodeType;
+
+private:
+    /** A type for the lexical analyzer. */
+    using lexer_type = detail::lexical_analyzer;
+    /** A type for the scalar parser. */
+    using scalar_parser_type = detail::scalar_parser<basic_node_type>;
+
+    /// @brief Definition of collection types being read.
+    enum class container_t : std::uint8_t {
+        BLOCK_MAPPING,  //!< a block mapping.
+        BLOCK_SEQUENCE, //!< a block sequence.
+        FLOW_MAPPING,   //!< a flow mapping.
+        FLOW_SEQUENCE,  //!< a flow sequence.
+    };
+
+    /// @brief A collection being read.
+    struct container_frame {
+        /// The collection type.
+        container_t type;
+        /// The indentation of the collection entries. (only used for block collections)
+        uint32_t indent;
+    };
+
+    /// @brief A lexical token with its position in the input.
+    struct token_info {
+        /// The lexical token.
+        detail::lexical_token token {};
+        /// The line where the token begins.
+        uint32_t line {0};
+        /// The column where the token begins.
+        uint32_t indent {0};
+        /// The header information if the token is a block scalar.
+        detail::block_scalar_header header {};
+    };
+
+public:
+    /// @brief Constructs a new basic_event_reader object.
+    /// @note The input is normalized into a buffer owned by the reader, just like in basic_node::deserialize().
+    /// @tparam InputType Type of a compatible input.
+    /// @param input An input source in the YAML format.
+    template <typename InputType>
+    explicit basic_event_reader(InputType&& input)
+        : m_buffer(),
+          m_lexer(init_buffer(detail::input_adapter(std::forward<InputType>(input)))) {
+        skip_directives();
+    }
+
+    /// @brief Constructs a new basic_event_reader object.
+    /// @tparam ItrType Type of a compatible iterator.
+    /// @param begin An iterator to the first element of an input sequence.
+    /// @param end An iterator to the past-the-last element of an input sequence.
+    template <typename ItrType>
+    basic_event_reader(ItrType begin, ItrType end)
+        : m_buffer(),
+          m_lexer(init_buffer(detail::input_adapter(std::forward<ItrType>(begin), std::forward<ItrType>(end)))) {
+        skip_directives();
+    }
+
+    // the lexer refers to the owned buffer.
+    basic_event_reader(const basic_event_reader&) = delete;
+    basic_event_reader& operator=(const basic_event_reader&) = delete;
+    basic_event_reader(basic_event_reader&&) = delete;
+    basic_event_reader& operator=(basic_event_reader&&) = delete;
+
+    /// @brief Destroys a basic_event_reader object.
+    ~basic_event_reader() = default;
+
+    /// @brief Reads the next event.
+    /// @return The type of the next event.
+    event_type next() {
+        if (m_value_pending) {
+            return read_value();
+        }
+
+        if (m_frames.empty()) {
+            return m_last_event = event_type::END_OF_DOCUMENT;
+        }
+
+        switch (m_frames.back().type) {
+        case container_t::BLOCK_MAPPING:
+            return read_block_mapping_entry();
+        case container_t::BLOCK_SEQUENCE:
+            return read_block_sequence_entry();
+        case container_t::FLOW_MAPPING:
+            return read_flow_mapping_entry();
+        case container_t::FLOW_SEQUENCE:
+            return read_flow_sequence_entry();
+        default:                   // LCOV_EXCL_LINE
+            detail::unreachable(); // LCOV_EXCL_LINE
+        }
+    }
+
+    /// @brief Discards the value of the last KEY event or the rest of the collection begun by the last event.
+    /// @note
+    /// A block node on the lines following its key is skipped by indentation without being scanned. Other nodes are
+    /// walked event by event without converting any scalar.
+    void skip() {
+        uint32_t depth = 0;
+        if (m_value_pending) {
+            const bool is_block_mapping_value = m_lookahead_count == 0 && !m_frames.empty() &&
+                                                m_frames.back().type == container_t::BLOCK_MAPPING;
+            if (is_block_mapping_value && m_lexer.skip_block_node(m_owner_indent)) {
+                m_value_pending = false;
+                return;
+            }
+
+            const event_type type = next();
+            depth = (type == event_type::MAPPING_BEGIN || type == event_type::SEQUENCE_BEGIN) ? 1 : 0;
+        }
+        else if (m_last_event == event_type::MAPPING_BEGIN || m_last_event == event_type::SEQUENCE_BEGIN) {
+            depth = 1;
+        }
+
+        while (depth > 0) {
+            switch (next()) {
+            case event_type::MAPPING_BEGIN:
+            case event_type::SEQUENCE_BEGIN:
+                ++depth;
+                break;
+            case event_type::MAPPING_END:
+            case event_type::SEQUENCE_END:
+                --depth;
+                break;
+            case event_type::END_OF_DOCUMENT: // LCOV_EXCL_LINE
+                return;                       // LCOV_EXCL_LINE
+            default:
+                break;
+            }
+        }
+    }
+
+    /// @brief Get the raw contents of the scalar of the last KEY or SCALAR event.
+    /// @note Quoted and block scalars are neither unescaped nor folded. Empty for an implicit null value.
+    /// @return View into the scalar contents, valid as long as this reader.
+    detail::str_view raw() const noexcept {
+        return m_scalar.token.str;
+    }
+
+    /// @brief Converts the scalar of the last KEY or SCALAR event into a node.
+    /// @return The scalar node. A null node for an implicit null value.
+    basic_node_type value() const {
+        FK_YAML_ASSERT(m_last_event == event_type::KEY || m_last_event == event_type::SCALAR);
+
+        scalar_parser_type parser(m_scalar.line, m_scalar.indent);
+        switch (m_scalar.token.type) {
+        case detail::lexical_token_t::PLAIN_SCALAR:
+        case detail::lexical_token_t::SINGLE_QUOTED_SCALAR:
+        case detail::lexical_token_t::DOUBLE_QUOTED_SCALAR:
+            return parser.parse_flow(m_scalar.token.type, detail::tag_t::NONE, m_scalar.token.str);
+        case detail::lexical_token_t::BLOCK_LITERAL_SCALAR:
+        case detail::lexical_token_t::BLOCK_FOLDED_SCALAR:
+            return parser.parse_block(m_scalar.token.type, detail::tag_t::NONE, m_scalar.token.str, m_scalar.header);
+        default:
+            return basic_node_type();
+        }
+    }
+
+    /// @brief Get the number of collections which are currently open.
+    /// @return The nesting depth. 0 at the root and after the document has been read.
+    std::size_t depth() const noexcept {
+        return m_frames.size();
+    }
+
+private:
+    /// @brief Copies the normalized input into the owned buffer.
+    /// @tparam InputAdapterType The type of an input adapter object.
+    /// @param input_adapter An input adapter object for the input source buffer.
+    /// @return View into the owned buffer.
+    template <typename InputAdapterType>
+    detail::str_view init_buffer(InputAdapterType&& input_adapter) { // NOLINT(cppcoreguidelines-missing-std-forward)
+        const detail::str_view input_view = input_adapter.get_buffer_view();
+        m_buffer.assign(input_view.begin(), input_view.end());
+        return m_buffer;
+    }
+
+    /// @brief Skips directives and the end of directives marker at the beginning of the document.
+    void skip_directives() {
+        m_lexer.set_document_state(true);
+        for (;;) {
+            m_lookahead[0] = fetch_token();
+            switch (m_lookahead[0].token.type) {
+            case detail::lexical_token_t::YAML_VER_DIRECTIVE:
+            case detail::lexical_token_t::TAG_DIRECTIVE:
+            case detail::lexical_token_t::INVALID_DIRECTIVE:
+            case detail::lexical_token_t::END_OF_DIRECTIVES:
+                break;
+            default:
+                m_lookahead_count = 1;
+                m_lexer.set_document_state(false);
+                return;
+            }
+        }
+    }
+
+    /// @brief Gets the next token from the lexer with its position.
+    /// @return The next token.
+    token_info fetch_token() {
+        token_info info;
+        info.token = m_lexer.get_next_token();
+        info.line = m_lexer.get_lines_processed();
+        info.indent = m_lexer.get_last_token_begin_pos();
+
+        switch (info.token.type) {
+        case detail::lexical_token_t::BLOCK_LITERAL_SCALAR:
+        case detail::lexical_token_t::BLOCK_FOLDED_SCALAR:
+            info.header = m_lexer.get_block_scalar_header();
+            break;
+        case detail::lexical_token_t::EXPLICIT_KEY_PREFIX:
+        case detail::lexical_token_t::ANCHOR_PREFIX:
+        case detail::lexical_token_t::ALIAS_PREFIX:
+        case detail::lexical_token_t::TAG_PREFIX:
+            throw parse_error(
+                "Explicit keys, anchors, aliases and tags are not supported by the event reader.",
+                info.line,
+                info.indent);
+        default:
+            break;
+        }
+
+        return info;
+    }
+
+    /// @brief Looks at a token ahead without consuming it.
+    /// @param n The number of tokens to look past. (0 or 1)
+    /// @return The token ahead.
+    const token_info& peek(uint32_t n = 0) {
+        FK_YAML_ASSERT(n < 2);
+        while (m_lookahead_count <= n) {
+            m_lookahead[m_lookahead_count++] = fetch_token();
+        }
+        return m_lookahead[n];
+    }
+
+    /// @brief Consumes the first token ahead.
+    /// @return The consumed token.
+    token_info consume() {
+        peek();
+        token_info info = m_lookahead[0];
+        m_lookahead[0] = m_lookahead[1];
+        --m_lookahead_count;
+        return info;
+    }
+
+    /// @brief Check if the given token ends the document.
+    /// @param type A lexical token type.
+    /// @return true if the token ends the document, false otherwise.
+    static bool is_end_of_document(detail::lexical_token_t type) noexcept {
+        return type == detail::lexical_token_t::END_OF_BUFFER || type == detail::lexical_token_t::END_OF_DIRECTIVES ||
+               type == detail::lexical_token_t::END_OF_DOCUMENT;
+    }
+
+    /// @brief Check if the given token is a flow scalar (plain, single quoted or double quoted).
+    /// @param type A lexical token type.
+    /// @return true if the token is a flow scalar, false otherwise.
+    static bool is_flow_scalar(detail::lexical_token_t type) noexcept {
+        return type == detail::lexical_token_t::PLAIN_SCALAR || type == detail::lexical_token_t::SINGLE_QUOTED_SCALAR ||
+               type == detail::lexical_token_t::DOUBLE_QUOTED_SCALAR;
+    }
+
+    /// @brief Check if a flow collection is being read.
+    /// @return true if in a flow context, false otherwise.
+    bool is_flow_context() const noexcept {
+        // block collections cannot be nested in flow collections.
+        return !m_frames.empty() && (m_frames.back().type == container_t::FLOW_MAPPING ||
+                                     m_frames.back().type == container_t::FLOW_SEQUENCE);
+    }
+
+    /// @brief Expects a value owned by the key or the block sequence entry at the given position.
+    /// @param line The line of the owner.
+    /// @param indent The indentation of the owner.
+    void expect_value(uint32_t line, uint32_t indent) noexcept {
+        m_value_pending = true;
+        m_owner_line = line;
+        m_owner_indent = indent;
+    }
+
+    /// @brief Check if the given token begins the pending value, or the value is an implicit null.
+    /// @param info The first token ahead.
+    /// @return true if the token belongs to the pending value, false otherwise.
+    bool begins_pending_value(const token_info& info) const noexcept {
+        switch (info.token.type) {
+        case detail::lexical_token_t::END_OF_BUFFER:
+        case detail::lexical_token_t::END_OF_DIRECTIVES:
+        case detail::lexical_token_t::END_OF_DOCUMENT:
+        case detail::lexical_token_t::KEY_SEPARATOR:
+        case detail::lexical_token_t::VALUE_SEPARATOR:
+        case detail::lexical_token_t::SEQUENCE_FLOW_END:
+        case detail::lexical_token_t::MAPPING_FLOW_END:
+            return false;
+        default:
+            break;
+        }
+
+        if (m_frames.empty() || is_flow_context()) {
+            return true;
+        }
+        if (info.line == m_owner_line || info.indent > m_owner_indent) {
+            return true;
+        }
+
+        // a block sequence can be indented as much as the mapping key which owns it.
+        return info.token.type == detail::lexical_token_t::SEQUENCE_BLOCK_PREFIX &&
+               m_frames.back().type == container_t::BLOCK_MAPPING && info.indent == m_owner_indent;
+    }
+
+    /// @brief Reads the pending value of a key, a sequence entry or the root.
+    /// @return The type of the event.
+    event_type read_value() {
+        m_value_pending = false;
+
+        const token_info& first = peek();
+        if (!begins_pending_value(first)) {
+            m_scalar = token_info();
+            m_scalar.line = first.line;
+            m_scalar.indent = first.indent;
+            return m_last_event = event_type::SCALAR;
+        }
+
+        switch (first.token.type) {
+        case detail::lexical_token_t::SEQUENCE_BLOCK_PREFIX:
+            // the prefix is consumed as the first entry of the sequence.
+            m_frames.push_back({container_t::BLOCK_SEQUENCE, first.indent});
+            return m_last_event = event_type::SEQUENCE_BEGIN;
+        case detail::lexical_token_t::SEQUENCE_FLOW_BEGIN:
+            consume();
+            FK_YAML_ASSERT(m_lookahead_count == 0);
+            m_frames.push_back({container_t::FLOW_SEQUENCE, 0});
+            m_lexer.set_context_state(true);
+            return m_last_event = event_type::SEQUENCE_BEGIN;
+        case detail::lexical_token_t::MAPPING_FLOW_BEGIN:
+            consume();
+            FK_YAML_ASSERT(m_lookahead_count == 0);
+            m_frames.push_back({container_t::FLOW_MAPPING, 0});
+            m_lexer.set_context_state(true);
+            return m_last_event = event_type::MAPPING_BEGIN;
+        case detail::lexical_token_t::PLAIN_SCALAR:
+        case detail::lexical_token_t::SINGLE_QUOTED_SCALAR:
+        case detail::lexical_token_t::DOUBLE_QUOTED_SCALAR:
+            if (!is_flow_context() && peek(1).token.type == detail::lexical_token_t::KEY_SEPARATOR) {
+                // the key is consumed as the first entry of the mapping.
+                m_frames.push_back({container_t::BLOCK_MAPPING, m_lookahead[0].indent});
+                return m_last_event = event_type::MAPPING_BEGIN;
+            }
+            m_scalar = consume();
+            return m_last_event = event_type::SCALAR;
+        case detail::lexical_token_t::BLOCK_LITERAL_SCALAR:
+        case detail::lexical_token_t::BLOCK_FOLDED_SCALAR:
+            m_scalar = consume();
+            return m_last_event = event_type::SCALAR;
+        default:
+            throw parse_error("Unexpected token found for a node.", first.line, first.indent);
+        }
+    }
+
+    /// @brief Reads the next key of the current block mapping or closes it.
+    /// @return The type of the event.
+    event_type read_block_mapping_entry() {
+        const uint32_t indent = m_frames.back().indent;
+
+        const token_info& first = peek();
+        if (is_end_of_document(first.token.type) || first.indent < indent) {
+            return close_container(event_type::MAPPING_END);
+        }
+
+        const bool is_key = first.indent == indent && is_flow_scalar(first.token.type) &&
+                            peek(1).token.type == detail::lexical_token_t::KEY_SEPARATOR;
+        if FK_YAML_UNLIKELY (!is_key) {
+            throw parse_error("Invalid block mapping entry found.", m_lookahead[0].line, m_lookahead[0].indent);
+        }
+
+        m_scalar = consume();
+        consume(); // the key separator
+        expect_value(m_scalar.line, indent);
+        return m_last_event = event_type::KEY;
+    }
+
+    /// @brief Reads the next entry of the current block sequence or closes it.
+    /// @return The type of the event.
+    event_type read_block_sequence_entry() {
+        const uint32_t indent = m_frames.back().indent;
+
+        const token_info& first = peek();
+        if (first.token.type == detail::lexical_token_t::SEQUENCE_BLOCK_PREFIX && first.indent == indent) {
+            const token_info prefix = consume();
+            expect_value(prefix.line, indent);
+            return read_value();
+        }
+
+        if FK_YAML_UNLIKELY (!is_end_of_document(first.token.type) && first.indent > indent) {
+            throw parse_error("Invalid block sequence entry found.", first.line, first.indent);
+        }
+        return close_container(event_type::SEQUENCE_END);
+    }
+
+    /// @brief Reads the next key of the current flow mapping or closes it.
+    /// @return The type of the event.
+    event_type read_flow_mapping_entry() {
+        if (peek().token.type == detail::lexical_token_t::VALUE_SEPARATOR) {
+            consume();
+        }
+
+        const token_info& first = peek();
+        if (first.token.type == detail::lexical_token_t::MAPPING_FLOW_END) {
+            consume();
+            return close_container(event_type::MAPPING_END);
+        }
+        if FK_YAML_UNLIKELY (!is_flow_scalar(first.token.type)) {
+            throw parse_error("Invalid flow mapping entry found.", first.line, first.indent);
+        }
+
+        m_scalar = consume();
+        if (peek().token.type == detail::lexical_token_t::KEY_SEPARATOR) {
+            consume();
+        }
+        // a key without the separator has an implicit null value.
+        expect_value(m_scalar.line, m_scalar.indent);
+        return m_last_event = event_type::KEY;
+    }
+
+    /// @brief Reads the next entry of the current flow sequence or closes it.
+    /// @return The type of the event.
+    event_type read_flow_sequence_entry() {
+        if (peek().token.type == detail::lexical_token_t::VALUE_SEPARATOR) {
+            consume();
+        }
+
+        const token_info& first = peek();
+        if (first.token.type == detail::lexical_token_t::SEQUENCE_FLOW_END) {
+            consume();
+            return close_container(event_type::SEQUENCE_END);
+        }
+        if FK_YAML_UNLIKELY (is_end_of_document(first.token.type)) {
+            throw parse_error("Flow sequence is not closed.", first.line, first.indent);
+        }
+
+        expect_value(first.line, first.indent);
+        return read_value();
+    }
+
+    /// @brief Closes the current collection.
+    /// @param type The event type for the end of the collection.
+    /// @return The given event type.
+    event_type close_container(event_type type) {
+        const bool was_flow_context = is_flow_context();
+        m_frames.pop_back();
+        if (was_flow_context && !is_flow_context()) {
+            // the closing bracket has been consumed and nothing has been scanned after it yet.
+            FK_YAML_ASSERT(m_lookahead_count == 0);
+            m_lexer.set_context_state(false);
+        }
+        return m_last_event = type;
+    }
+
+    /// The normalized input.
+    std::string m_buffer;
+    /// The lexical analyzer over the normalized input.
+    lexer_type m_lexer;
+    /// Collections being read, from the outermost to the innermost.
+    std::vector<container_frame> m_frames {};
+    /// Tokens scanned ahead of the current event.
+    token_info m_lookahead[2] {};
+    /// The number of tokens scanned ahead.
+    uint32_t m_lookahead_count {0};
+    /// The scalar of the last KEY or SCALAR event.
+    token_info m_scalar {};
+    /// The type of the last event.
+    event_type m_last_event {event_type::END_OF_DOCUMENT};
+    /// Whether the next event is a value of a key, of a sequence entry or of the root.
+    bool m_value_pending {true};
+    /// The line of the key or the block sequence entry which owns the pending value.
+    uint32_t m_owner_line {0};
+    /// The indentation of the key or the block sequence entry which owns the pending value.
+    uint32_t m_owner_indent {0};
+};
+
+/// @brief default YAML event reader.
+using event_reader = basic_event_reader<node>;
+
+FK_YAML_NAMESPACE_END
+
+#endif /* FK_YAML_EVENT_READER_HPP */
+
 // #include <fkYAML/detail/iterator.hpp>
 //  _______   __ __   __  _____   __  __  __
 // |   __| |_/  |  \_/  |/  _  \ /  \/  \|  |     fkYAML: A C++ header-only YAML library
@@ -10663,7 +11372,9 @@ FK_YAML_DETAIL_NAMESPACE_END
 #ifndef FK_YAML_DETAIL_CONVERSIONS_TO_STRING_HPP
 #define FK_YAML_DETAIL_CONVERSIONS_TO_STRING_HPP
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <string>
 #include <sstream>
@@ -10676,8 +11387,75 @@ FK_YAML_DETAIL_NAMESPACE_END
 // #include <fkYAML/detail/meta/type_traits.hpp>
 
 
+#if FK_YAML_HAS_TO_CHARS
+#include <charconv>
+#endif
+
 FK_YAML_DETAIL_NAMESPACE_BEGIN
 
+/// @brief The size of a character buffer large enough for any float_to_chars() result.
+constexpr std::size_t float_chars_buffer_size = 64;
+
+/// @brief Writes a floating point number as a YAML token into a character buffer.
+/// @note The shortest representation which reads back to the same value is used if std::to_chars() is available.
+/// Exponents are written without leading zeros (1e-6, not 1e-06) and ".0" is appended to integral values so that
+/// they are not read back as integers. https://github.com/fktn-k/fkYAML/issues/405
+/// @tparam FloatType A floating point number type.
+/// @param first The beginning of the output buffer.
+/// @param last The end of the output buffer. At least float_chars_buffer_size characters must be available.
+/// @param v A floating point number source value.
+/// @return The past-the-end pointer of the written characters.
+template <typename FloatType>
+inline char* float_to_chars(char* first, char* last, FloatType v) {
+    static_assert(std::is_floating_point<FloatType>::value, "float_to_chars() accepts floating point types");
+    FK_YAML_ASSERT(static_cast<std::size_t>(last - first) >= float_chars_buffer_size);
+
+    if (std::isnan(v)) {
+        std::memcpy(first, ".nan", 4);
+        return first + 4;
+    }
+
+    if (std::isinf(v)) {
+        if (v == std::numeric_limits<FloatType>::infinity()) {
+            std::memcpy(first, ".inf", 4);
+            return first + 4;
+        }
+        std::memcpy(first, "-.inf", 5);
+        return first + 5;
+    }
+
+#if FK_YAML_HAS_TO_CHARS
+    char* p_end = std::to_chars(first, last, v).ptr;
+#else
+    // not the shortest form, but at least one that reads back to the same value.
+    std::ostringstream oss;
+    oss.precision(std::numeric_limits<FloatType>::max_digits10);
+    oss << v;
+    const std::string str = oss.str();
+    char* p_end = std::copy(str.begin(), str.end(), first);
+    static_cast<void>(last);
+#endif
+
+    char* p_exp = std::find(first, p_end, 'e');
+    if (p_exp == p_end) {
+        if (std::find(first, p_end, '.') == p_end) {
+            *p_end++ = '.';
+            *p_end++ = '0';
+        }
+        return p_end;
+    }
+
+    char* p_exp_digits = p_exp + 1;
+    if (*p_exp_digits == '+' || *p_exp_digits == '-') {
+        ++p_exp_digits;
+    }
+    char* p_significant = p_exp_digits;
+    while (p_significant + 1 < p_end && *p_significant == '0') {
+        ++p_significant;
+    }
+    return std::copy(p_significant, p_end, p_exp_digits);
+}
+
 /// @brief Converts a ValueType object to a string YAML token.
 /// @tparam ValueType A source value type.
 /// @tparam CharType The type of characters for the conversion result.
@@ -10717,31 +11495,8 @@ inline enable_if_t<is_non_bool_integral<IntegerType>::value> to_string(IntegerTy
 /// @param f A floating point number source value.
 template <typename FloatType>
 inline enable_if_t<std::is_floating_point<FloatType>::value> to_string(FloatType v, std::string& s) noexcept {
-    if (std::isnan(v)) {
-        s = ".nan";
-        return;
-    }
-
-    if (std::isinf(v)) {
-        if (v == std::numeric_limits<FloatType>::infinity()) {
-            s = ".inf";
-        }
-        else {
-            s = "-.inf";
-        }
-        return;
-    }
-
-    std::ostringstream oss;
-    oss << v;
-    s = oss.str();
-
-    // If `v` is actually an integer and no scientific notation is used for serialization, ".0" must be appended.
-    // The result would cause a roundtrip issue otherwise. https://github.com/fktn-k/fkYAML/issues/405
-    const std::size_t pos = s.find_first_of(".e");
-    if (pos == std::string::npos) {
-        s += ".0";
-    }
+    char buffer[float_chars_buffer_size];
+    s.assign(buffer, float_to_chars(buffer, buffer + float_chars_buffer_size, v));
 }
 
 FK_YAML_DETAIL_NAMESPACE_END
@@ -10823,6 +11578,11 @@ private:
         const auto& p_meta = node.mp_meta;
         bool needs_directive_end = false;
 
+        if (!p_meta) {
+            // no directive has ever been applied to the node.
+            return false;
+        }
+
         if (p_meta->is_version_specified) {
             str += "%YAML ";
             switch (p_meta->version) {
@@ -10995,10 +11755,16 @@ private:
             to_string(node.template get_value<typename BasicNodeType::integer_type>(), m_tmp_str_buff);
             str += m_tmp_str_buff;
             break;
-        case node_type::FLOAT:
-            to_string(node.template get_value<typename BasicNodeType::float_number_type>(), m_tmp_str_buff);
-            str += m_tmp_str_buff;
+        case node_type::FLOAT: {
+            // Written straight into the output so that long float sequences need no temporary string per element.
+            char buffer[float_chars_buffer_size];
+            const char* p_end = float_to_chars(
+                buffer,
+                buffer + float_chars_buffer_size,
+                node.template get_value<typename BasicNodeType::float_number_type>());
+            str.append(buffer, static_cast<std::size_t>(p_end - buffer));
             break;
+        }
         case node_type::STRING: {
             bool is_escaped = false;
             auto str_val = get_string_node_value(node, is_escaped);
@@ -13806,13 +14572,14 @@ public:
     /// @return The YAML version if already set, `yaml_version_type::VERSION_1_2` otherwise.
     /// @sa https://fktn-k.github.io/fkYAML/api/basic_node/get_yaml_version_type/
     yaml_version_type get_yaml_version_type() const noexcept {
-        return mp_meta->is_version_specified ? mp_meta->version : yaml_version_type::VERSION_1_2;
+        return (mp_meta && mp_meta->is_version_specified) ? mp_meta->version : yaml_version_type::VERSION_1_2;
     }
 
     /// @brief Set the YAML version for this basic_node object.
     /// @param[in] version The target YAML version.
     /// @sa https://fktn-k.github.io/fkYAML/api/basic_node/set_yaml_version_type/
-    void set_yaml_version_type(const yaml_version_type version) noexcept {
+    void set_yaml_version_type(const yaml_version_type version) {
+        ensure_meta();
         mp_meta->version = version;
         mp_meta->is_version_specified = true;
     }
@@ -13832,7 +14599,7 @@ public:
     /// @param[in] version The target YAML version.
     /// @sa https://fktn-k.github.io/fkYAML/api/basic_node/set_yaml_version/
     FK_YAML_DEPRECATED("Since 0.3.12; Use set_yaml_version_type(const yaml_version_type)")
-    void set_yaml_version(const yaml_version_t version) noexcept {
+    void set_yaml_version(const yaml_version_t version) {
         set_yaml_version_type(detail::convert_to_yaml_version_type(version));
     }
 
@@ -13869,6 +14636,7 @@ public:
             mp_meta->anchor_table.erase(itr);
         }
 
+        ensure_meta();
         auto p_meta = mp_meta;
 
         basic_node node;
@@ -13897,6 +14665,7 @@ public:
             mp_meta->anchor_table.erase(itr);
         }
 
+        ensure_meta();
         auto p_meta = mp_meta;
 
         basic_node node;
@@ -14526,12 +15295,19 @@ private:
         return as_str();
     }
 
+    /// @brief Creates the shared set of YAML directives for this basic_node if it has none yet.
+    void ensure_meta() const {
+        if (!mp_meta) {
+            mp_meta = std::make_shared<detail::document_metainfo<basic_node>>();
+        }
+    }
+
     /// The current node attributes.
     detail::node_attr_t m_attrs {detail::node_attr_bits::default_bits};
     /// The shared set of YAML directives applied to this node.
-    mutable std::shared_ptr<detail::document_metainfo<basic_node>> mp_meta {
-        // NOLINTNEXTLINE(bugprone-unhandled-exception-at-new)
-        std::shared_ptr<detail::document_metainfo<basic_node>>(new detail::document_metainfo<basic_node>())};
+    /// @note Created on demand so that standalone scalar nodes cost no heap allocation. Deserialized nodes share the
+    /// one of their document.
+    mutable std::shared_ptr<detail::document_metainfo<basic_node>> mp_meta {};
     /// The current node value.
     node_value m_value {};
     /// The property set of this node.
@@ -0,0 +1,543 @@
+#include "AmplificationCurveItem.hpp"
+#include "CurveDecimator.hpp"
+#include "ExperimentOverlay.hpp"
+
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr int CLEAN = INT_MAX;
+// Lowest value on a log scale, a reading of 0 lx would be drawn at -infinity
+constexpr double LOG_FLOOR = 1e-3;
+constexpr float LINE_WIDTH = 2.0f;
+// Up to this many points per pixel column a curve is drawn as it is
+constexpr int RAW_POINTS_PER_COLUMN = 2;
+
+QSGGeometryNode* createCurveNode(const QColor& color)
+{
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+    geometry->setLineWidth(LINE_WIDTH);
+    auto* material = new QSGFlatColorMaterial;
+    material->setColor(color);
+
+    auto* node = new QSGGeometryNode;
+    node->setGeometry(geometry);
+    node->setMaterial(material);
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
+
+double scaled(double value, bool logScale)
+{
+    return logScale ? std::log10(std::max(value, LOG_FLOOR)) : value;
+}
+}
+
+AmplificationCurveItem::AmplificationCurveItem(QQuickItem* parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+    Curve live;
+    live.color = m_color;
+    m_curves.push_back(live);
+}
+
+DataManager* AmplificationCurveItem::dataManager() const
+{
+    return m_dataManager.data();
+}
+
+void AmplificationCurveItem::setDataManager(DataManager* dataManager)
+{
+    if(m_dataManager == dataManager) return;
+
+    if(m_dataManager)
+    {
+        disconnect(m_dataManager.data(), nullptr, this, nullptr);
+    }
+    m_dataManager = dataManager;
+    if(m_dataManager)
+    {
+        connect(m_dataManager.data(), &DataManager::intensityValuesUpdated,
+                this, &AmplificationCurveItem::onIntensityValueUpdated);
+        connect(m_dataManager.data(), &DataManager::intensityValuesReset,
+                this, &AmplificationCurveItem::onIntensityValuesReset);
+        connect(m_dataManager.data(), &DataManager::maxCycleChanged,
+                this, &AmplificationCurveItem::onIntensityValuesReloaded);
+        connect(m_dataManager.data(), &DataManager::currentExperimentNameChanged,
+                this, &AmplificationCurveItem::onIntensityValuesReloaded);
+    }
+    emit dataManagerChanged();
+    onIntensityValuesReloaded();
+}
+
+double AmplificationCurveItem::xMin() const
+{
+    return m_xMin;
+}
+
+void AmplificationCurveItem::setXMin(double xMin)
+{
+    if(m_xMin == xMin) return;
+    m_xMin = xMin;
+    invalidateAll();
+    emit rangeChanged();
+}
+
+double AmplificationCurveItem::xMax() const
+{
+    return m_xMax;
+}
+
+void AmplificationCurveItem::setXMax(double xMax)
+{
+    if(m_xMax == xMax) return;
+    m_xMax = xMax;
+    invalidateAll();
+    emit rangeChanged();
+}
+
+double AmplificationCurveItem::yMin() const
+{
+    return m_yMin;
+}
+
+void AmplificationCurveItem::setYMin(double yMin)
+{
+    if(m_yMin == yMin) return;
+    m_yMin = yMin;
+    invalidateAll();
+    emit rangeChanged();
+}
+
+double AmplificationCurveItem::yMax() const
+{
+    return m_yMax;
+}
+
+void AmplificationCurveItem::setYMax(double yMax)
+{
+    if(m_yMax == yMax) return;
+    m_yMax = yMax;
+    invalidateAll();
+    emit rangeChanged();
+}
+
+bool AmplificationCurveItem::logScale() const
+{
+    return m_logScale;
+}
+
+void AmplificationCurveItem::setLogScale(bool logScale)
+{
+    if(m_logScale == logScale) return;
+    m_logScale = logScale;
+    invalidateAll();
+    emit logScaleChanged();
+}
+
+QColor AmplificationCurveItem::color() const
+{
+    return m_color;
+}
+
+void AmplificationCurveItem::setColor(const QColor& color)
+{
+    if(m_color == color) return;
+    m_color = color;
+    m_curves.front().color = color;
+    m_curves.front().rebuild = true;
+    update();
+    emit colorChanged();
+}
+
+ExperimentOverlay* AmplificationCurveItem::overlay() const
+{
+    return m_overlay.data();
+}
+
+void AmplificationCurveItem::setOverlay(ExperimentOverlay* overlay)
+{
+    if(m_overlay == overlay) return;
+
+    if(m_overlay)
+    {
+        disconnect(m_overlay.data(), nullptr, this, nullptr);
+    }
+    m_overlay = overlay;
+    if(m_overlay)
+    {
+        connect(m_overlay.data(), &ExperimentOverlay::curvesChanged,
+                this, &AmplificationCurveItem::onOverlayCurvesChanged);
+    }
+    emit overlayChanged();
+    onOverlayCurvesChanged();
+}
+
+double AmplificationCurveItem::dataMaximum() const
+{
+    return m_dataMaximum;
+}
+
+void AmplificationCurveItem::setCurves(const QList<PlotCurve>& curves)
+{
+    m_curves.resize(1);
+    for(const auto& plotCurve : curves)
+    {
+        if(!plotCurve.values) continue;
+        Curve curve;
+        curve.values = plotCurve.values;
+        curve.color = plotCurve.color;
+        m_curves.push_back(curve);
+    }
+    m_nodesChanged = true;
+    recomputeDataMaximum();
+    update();
+}
+
+void AmplificationCurveItem::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if(newGeometry.size() != oldGeometry.size())
+    {
+        invalidateAll();
+    }
+}
+
+void AmplificationCurveItem::onIntensityValueUpdated(int index, float value)
+{
+    if(index < 0) return;
+
+    Curve& live = m_curves.front();
+    live.dirtyFrom = std::min(live.dirtyFrom, index);
+    m_liveCount = std::max(m_liveCount, index + 1);
+    if(value > m_dataMaximum)
+    {
+        m_dataMaximum = value;
+        emit dataMaximumChanged();
+    }
+    update();
+}
+
+void AmplificationCurveItem::onIntensityValuesReset()
+{
+    // The list keeps its size, but none of it has been read in the new run
+    m_liveCount = 0;
+    m_curves.front().rebuild = true;
+    recomputeDataMaximum();
+    update();
+}
+
+void AmplificationCurveItem::onIntensityValuesReloaded()
+{
+    m_liveCount = m_dataManager ? static_cast<int>(m_dataManager->getIntensityValuesList().size()) : 0;
+    m_curves.front().rebuild = true;
+    recomputeDataMaximum();
+    update();
+}
+
+void AmplificationCurveItem::onOverlayCurvesChanged()
+{
+    setCurves(m_overlay ? m_overlay->curves() : QList<PlotCurve>());
+}
+
+const QList<float>& AmplificationCurveItem::valuesOf(const Curve& curve) const
+{
+    static const QList<float> noValues;
+    if(curve.values) return *curve.values;
+    return m_dataManager ? m_dataManager->getIntensityValuesList() : noValues;
+}
+
+int AmplificationCurveItem::countOf(const Curve& curve) const
+{
+    const int size = static_cast<int>(valuesOf(curve).size());
+    return curve.values ? size : std::min(m_liveCount, size);
+}
+
+float AmplificationCurveItem::mapX(int index) const
+{
+    const double span = m_xMax - m_xMin;
+    if(span <= 0.0) return 0.0f;
+    // Reading k is cycle k + 1
+    return static_cast<float>((index + 1 - m_xMin) / span * width());
+}
+
+float AmplificationCurveItem::mapY(float value) const
+{
+    const double low = scaled(m_yMin, m_logScale);
+    const double span = scaled(m_yMax, m_logScale) - low;
+    if(span <= 0.0) return static_cast<float>(height());
+    return static_cast<float>(height() - (scaled(value, m_logScale) - low) / span * height());
+}
+
+void AmplificationCurveItem::invalidateAll()
+{
+    for(auto& curve : m_curves)
+    {
+        curve.rebuild = true;
+    }
+    update();
+}
+
+void AmplificationCurveItem::recomputeDataMaximum()
+{
+    double maximum = 0.0;
+    for(const auto& curve : m_curves)
+    {
+        const QList<float>& values = valuesOf(curve);
+        const int count = countOf(curve);
+        for(int i = 0; i < count; ++i)
+        {
+            maximum = std::max<double>(maximum, values[i]);
+        }
+    }
+    if(maximum == m_dataMaximum) return;
+    m_dataMaximum = maximum;
+    emit dataMaximumChanged();
+}
+
+QSGNode* AmplificationCurveItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*)
+{
+    QSGNode* root = oldNode;
+    if(!root)
+    {
+        root = new QSGNode;
+        m_nodesChanged = true;
+    }
+
+    // One node per curve, in the order of m_curves
+    if(m_nodesChanged)
+    {
+        while(QSGNode* child = root->firstChild())
+        {
+            root->removeChildNode(child);
+            delete child;
+        }
+        for(auto& curve : m_curves)
+        {
+            root->appendChildNode(createCurveNode(curve.color));
+            curve.rebuild = true;
+        }
+        m_nodesChanged = false;
+    }
+
+    QSGNode* child = root->firstChild();
+    for(auto& curve : m_curves)
+    {
+        auto* node = static_cast<QSGGeometryNode*>(child);
+        if(curve.rebuild)
+        {
+            rebuildCurve(curve, node);
+        }
+        else if(curve.dirtyFrom != CLEAN)
+        {
+            updateCurve(curve, node);
+        }
+        curve.rebuild = false;
+        curve.dirtyFrom = CLEAN;
+        child = child->nextSibling();
+    }
+    return root;
+}
+
+void AmplificationCurveItem::rebuildCurve(Curve& curve, QSGGeometryNode* node)
+{
+    const QList<float>& values = valuesOf(curve);
+    const int count = countOf(curve);
+    const int columns = std::max(1, static_cast<int>(std::ceil(width())));
+
+    static_cast<QSGFlatColorMaterial*>(node->material())->setColor(curve.color);
+    curve.drawnCount = count;
+    curve.columnMinimum.clear();
+    curve.columnMaximum.clear();
+    curve.lastColumn = -1;
+
+    QSGGeometry* geometry = node->geometry();
+    if(count <= RAW_POINTS_PER_COLUMN * columns)
+    {
+        curve.mode = Mode::Raw;
+        geometry->allocate(count);
+        QSGGeometry::Point2D* vertices = geometry->vertexDataAsPoint2D();
+        for(int i = 0; i < count; ++i)
+        {
+            vertices[i].set(mapX(i), mapY(values[i]));
+        }
+        node->markDirty(QSGNode::DirtyGeometry | QSGNode::DirtyMaterial);
+        return;
+    }
+
+    std::vector<float> x(count);
+    std::vector<float> y(count);
+    for(int i = 0; i < count; ++i)
+    {
+        x[i] = mapX(i);
+        y[i] = mapY(values[i]);
+    }
+
+    if(curve.values)
+    {
+        // Complete curve, nothing will be appended to it
+        curve.mode = Mode::Lttb;
+        const std::vector<int> kept = CurveDecimator::largestTriangleThreeBuckets(x.data(), y.data(), count, columns);
+        geometry->allocate(static_cast<int>(kept.size()));
+        QSGGeometry::Point2D* vertices = geometry->vertexDataAsPoint2D();
+        for(size_t i = 0; i < kept.size(); ++i)
+        {
+            vertices[i].set(x[kept[i]], y[kept[i]]);
+        }
+        node->markDirty(QSGNode::DirtyGeometry | QSGNode::DirtyMaterial);
+        return;
+    }
+
+    curve.mode = Mode::MinMax;
+    curve.columnMinimum.resize(columns);
+    curve.columnMaximum.resize(columns);
+    CurveDecimator::minMax(x.data(), y.data(), count, columns, curve.columnMinimum.data(), curve.columnMaximum.data());
+    for(int column = columns - 1; column >= 0; --column)
+    {
+        if(!std::isnan(curve.columnMinimum[column]))
+        {
+            curve.lastColumn = column;
+            break;
+        }
+    }
+    geometry->allocate(2 * (curve.lastColumn + 1));
+    writeColumns(curve, node, 0, curve.lastColumn);
+    node->markDirty(QSGNode::DirtyGeometry | QSGNode::DirtyMaterial);
+}
+
+void AmplificationCurveItem::updateCurve(Curve& curve, QSGGeometryNode* node)
+{
+    const QList<float>& values = valuesOf(curve);
+    const int count = countOf(curve);
+    const int columns = std::max(1, static_cast<int>(std::ceil(width())));
+    // Fewer readings than drawn (a new run) or a decimated curve that has to change its mode
+    if(count < curve.drawnCount || curve.mode == Mode::Lttb ||
+       (curve.mode == Mode::Raw && count > RAW_POINTS_PER_COLUMN * columns))
+    {
+        rebuildCurve(curve, node);
+        return;
+    }
+
+    QSGGeometry* geometry = node->geometry();
+    if(curve.mode == Mode::Raw)
+    {
+        // Appended readings need more vertices, allocate() drops the old ones
+        const int first = count > curve.drawnCount ? 0 : curve.dirtyFrom;
+        if(count > curve.drawnCount)
+        {
+            geometry->allocate(count);
+        }
+        QSGGeometry::Point2D* vertices = geometry->vertexDataAsPoint2D();
+        for(int i = first; i < count; ++i)
+        {
+            vertices[i].set(mapX(i), mapY(values[i]));
+        }
+        curve.drawnCount = count;
+        node->markDirty(QSGNode::DirtyGeometry);
+        return;
+    }
+
+    // Min-max: only the columns of the changed readings
+    const int previousLastColumn = curve.lastColumn;
+    int firstChangedColumn = columns;
+    int lastChangedColumn = -1;
+    int column = -1;
+    for(int i = curve.dirtyFrom; i < count; ++i)
+    {
+        const float x = mapX(i);
+        if(!(x >= 0.0f && x < columns) || static_cast<int>(x) == column) continue;
+        column = static_cast<int>(x);
+        updateColumn(curve, column, values, count);
+        firstChangedColumn = std::min(firstChangedColumn, column);
+        lastChangedColumn = std::max(lastChangedColumn, column);
+    }
+    curve.drawnCount = count;
+    if(lastChangedColumn < 0) return;
+
+    if(curve.lastColumn != previousLastColumn)
+    {
+        geometry->allocate(2 * (curve.lastColumn + 1));
+        writeColumns(curve, node, 0, curve.lastColumn);
+    }
+    else
+    {
+        writeColumns(curve, node, firstChangedColumn, lastChangedColumn);
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+void AmplificationCurveItem::updateColumn(Curve& curve, int column, const QList<float>& values, int count)
+{
+    if(width() <= 0.0) return;
+
+    // Readings of one column are contiguous, they are found around any one of them
+    const double span = m_xMax - m_xMin;
+    const int center = static_cast<int>(std::floor(m_xMin - 1 + (column + 0.5) * span / width()));
+    int first = std::clamp(center, 0, count - 1);
+    while(first > 0 && static_cast<int>(std::floor(mapX(first - 1))) >= column)
+    {
+        --first;
+    }
+    while(first < count && static_cast<int>(std::floor(mapX(first))) < column)
+    {
+        ++first;
+    }
+
+    float minimum = std::numeric_limits<float>::quiet_NaN();
+    float maximum = std::numeric_limits<float>::quiet_NaN();
+    for(int i = first; i < count && static_cast<int>(std::floor(mapX(i))) == column; ++i)
+    {
+        const float y = mapY(values[i]);
+        if(!(y >= minimum)) minimum = y;
+        if(!(y <= maximum)) maximum = y;
+    }
+    curve.columnMinimum[column] = minimum;
+    curve.columnMaximum[column] = maximum;
+    if(!std::isnan(minimum))
+    {
+        curve.lastColumn = std::max(curve.lastColumn, column);
+    }
+}
+
+void AmplificationCurveItem::writeColumns(const Curve& curve, QSGGeometryNode* node, int firstColumn, int lastColumn) const
+{
+    QSGGeometry::Point2D* vertices = node->geometry()->vertexDataAsPoint2D();
+    // An empty column continues the line at the height of the column before it
+    float previous = static_cast<float>(height());
+    for(int column = firstColumn - 1; column >= 0; --column)
+    {
+        if(!std::isnan(curve.columnMaximum[column]))
+        {
+            previous = curve.columnMaximum[column];
+            break;
+        }
+    }
+
+    for(int column = firstColumn; column <= lastColumn; ++column)
+    {
+        const float x = column + 0.5f;
+        const bool empty = std::isnan(curve.columnMinimum[column]);
+        const float minimum = empty ? previous : curve.columnMinimum[column];
+        const float maximum = empty ? previous : curve.columnMaximum[column];
+        // Alternate the order, so the strip runs down and up the columns instead of jumping back
+        if(column % 2 == 0)
+        {
+            vertices[2 * column].set(x, minimum);
+            vertices[2 * column + 1].set(x, maximum);
+            previous = maximum;
+        }
+        else
+        {
+            vertices[2 * column].set(x, maximum);
+            vertices[2 * column + 1].set(x, minimum);
+            previous = minimum;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include "BaselineEstimator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+constexpr int MAX_POINTS = BaselineEstimator::LAST_CYCLE - BaselineEstimator::FIRST_CYCLE + 1;
+// Scales the median absolute deviation to σ for normally distributed noise
+constexpr double MAD_SCALE = 1.4826;
+constexpr double MIN_RELATIVE_NOISE = 1e-3;
+
+// Reorders values, count must be > 0
+double median(double* values, int count)
+{
+    double* middle = values + count / 2;
+    std::nth_element(values, middle, values + count);
+    if(count % 2 == 1) return *middle;
+
+    // The lower middle is the largest value left of the upper one
+    return (*std::max_element(values, middle) + *middle) / 2.0;
+}
+}
+
+double BaselineEstimate::valueAt(double cycle) const
+{
+    return intercept + slope * cycle;
+}
+
+BaselineEstimate BaselineEstimator::estimate(const QList<float>& intensityValues, int sampleCount)
+{
+    BaselineEstimate baseline;
+    const int lastCycle = std::min<int>({LAST_CYCLE, sampleCount, static_cast<int>(intensityValues.size())});
+    const int count = lastCycle - FIRST_CYCLE + 1;
+    if(count < MIN_POINTS) return baseline;
+
+    std::array<double, MAX_POINTS * (MAX_POINTS - 1) / 2> slopes;
+    std::array<double, MAX_POINTS> values;
+    int slopeCount = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        const double y = intensityValues[FIRST_CYCLE - 1 + i];
+        for(int j = i + 1; j < count; ++j)
+        {
+            slopes[slopeCount++] = (intensityValues[FIRST_CYCLE - 1 + j] - y) / (j - i);
+        }
+    }
+    baseline.slope = median(slopes.data(), slopeCount);
+
+    for(int i = 0; i < count; ++i)
+    {
+        values[i] = intensityValues[FIRST_CYCLE - 1 + i] - baseline.slope * (FIRST_CYCLE + i);
+    }
+    baseline.intercept = median(values.data(), count);
+
+    for(int i = 0; i < count; ++i)
+    {
+        values[i] = std::abs(intensityValues[FIRST_CYCLE - 1 + i] - baseline.valueAt(FIRST_CYCLE + i));
+    }
+    const double level = std::abs(baseline.valueAt(lastCycle));
+    baseline.noise = std::max(MAD_SCALE * median(values.data(), count), MIN_RELATIVE_NOISE * std::max(level, 1.0));
+    baseline.threshold = NOISE_MULTIPLIER * baseline.noise;
+    baseline.valid = std::isfinite(baseline.threshold);
+    return baseline;
+}
+
+QList<float> BaselineEstimator::subtract(const QList<float>& intensityValues, const BaselineEstimate& baseline)
+{
+    QList<float> corrected(intensityValues.size());
+    for(qsizetype i = 0; i < intensityValues.size(); ++i)
+    {
+        corrected[i] = static_cast<float>(intensityValues[i] - baseline.valueAt(static_cast<double>(i + 1)));
+    }
+    return corrected;
+}
@@ -11,6 +11,24 @@
 ButtonHandler::ButtonHandler(QSharedPointer<DataManager> dm, QSharedPointer<HardwareController> hwc, QObject* parent)
     : QObject(parent), m_dataManager{dm}, m_hardwareController{hwc}
 {
+    // Early stop, the rest of the run goes on as if the last cycle had been read
+    connect(m_dataManager.data(), &DataManager::plateauReached, this, [this]() {
+        m_dataManager->setStopReason("plateau");
+        m_hardwareController->finishAmplification();
+    });
+
+    // Melt ramp right after the last amplification cycle, when it is enabled in setup
+    connect(m_hardwareController.data(), &HardwareController::amplificationFinished, this, [this]() {
+        if (m_dataManager->m_stopReason.isEmpty()) {
+            m_dataManager->setStopReason("max_cycle");
+        }
+        if (m_dataManager->m_meltEnabled) {
+            m_hardwareController->startMeltRamp();
+        } else {
+            finishRun();
+        }
+    });
+    connect(m_hardwareController.data(), &HardwareController::meltRampFinished, this, &ButtonHandler::finishRun);
 }
 
 void ButtonHandler::handleButtonClick(const QString &buttonName)
@@ -42,6 +60,8 @@ void ButtonHandler::handleButtonClick(const QString &buttonName)
 void ButtonHandler::handleRunStart()
 {
     m_dataManager->resetIntensityValues();
+    m_dataManager->resetMeltCurve();
+    m_dataManager->setStopReason("");
     if (!m_hardwareController->begin()) {
         throw std::runtime_error("Main: Failed to initialize hardware!");
     }
@@ -51,11 +71,25 @@ void ButtonHandler::handleRunStart()
 
 void ButtonHandler::handleRunStop()
 {
+    if (m_dataManager->m_stopReason.isEmpty()) {
+        m_dataManager->setStopReason("user");
+    }
     m_hardwareController->stopSensorReading();
+    // Stopping during the melt ramp keeps the part of the curve read so far
+    m_hardwareController->stopMeltRamp();
+    if (!m_dataManager->m_meltAnalyzer.curve().temperatures.isEmpty()) {
+        m_dataManager->finishMeltCurve();
+    }
     m_dataManager->setCycleThreshold();
     m_dataManager->calculateStandardCurve();
 }
 
+void ButtonHandler::finishRun()
+{
+    handleRunStop();
+    emit runFinished();
+}
+
 void ButtonHandler::saveDataClick()
 {
     auto resourceFolderName = getenv("RESOURCE_FOLDER_PATH");
@@ -0,0 +1,119 @@
+#include "CtEngine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+CtEngine::CtEngine(int wellCount, int cycleCount)
+    : m_wellCount{std::max(0, wellCount)},
+    m_cycleCount{std::max(0, cycleCount)},
+    m_values(static_cast<size_t>(m_wellCount) * m_cycleCount, 0.0f)
+{
+}
+
+int CtEngine::wellCount() const
+{
+    return m_wellCount;
+}
+
+int CtEngine::cycleCount() const
+{
+    return m_cycleCount;
+}
+
+void CtEngine::setCurve(int well, const QList<float>& intensityValues)
+{
+    if(well < 0 || well >= m_wellCount) return;
+
+    const int cycles = std::min<int>(m_cycleCount, intensityValues.size());
+    for(int cycle = 0; cycle < cycles; ++cycle)
+    {
+        m_values[static_cast<size_t>(cycle) * m_wellCount + well] = intensityValues[cycle];
+    }
+    for(int cycle = cycles; cycle < m_cycleCount; ++cycle)
+    {
+        m_values[static_cast<size_t>(cycle) * m_wellCount + well] = 0.0f;
+    }
+}
+
+float* CtEngine::cycleValues(int cycle)
+{
+    return m_values.data() + static_cast<size_t>(cycle) * m_wellCount;
+}
+
+void CtEngine::computeCt(double intensityThreshold, Interpolation interpolation, std::vector<double>& ct)
+{
+    const float threshold = floatThreshold(intensityThreshold);
+    // Locals, a store through firstCrossing could otherwise alias the members and block vectorization
+    const int wellCount = m_wellCount;
+    const int noCrossing = m_cycleCount;
+
+    m_firstCrossing.assign(wellCount, noCrossing);
+    int* firstCrossing = m_firstCrossing.data();
+    for(int cycle = 0; cycle < noCrossing; ++cycle)
+    {
+        const float* values = m_values.data() + static_cast<size_t>(cycle) * wellCount;
+        // No branches or early exits, this loop is meant to be vectorized
+        for(int well = 0; well < wellCount; ++well)
+        {
+            const int crossing = values[well] >= threshold ? cycle : noCrossing;
+            firstCrossing[well] = std::min(firstCrossing[well], crossing);
+        }
+    }
+
+    ct.resize(m_wellCount);
+    for(int well = 0; well < m_wellCount; ++well)
+    {
+        const int crossing = firstCrossing[well];
+        if(crossing == noCrossing)
+        {
+            ct[well] = -1.0;
+        }
+        else if(crossing == 0)
+        {
+            ct[well] = 1.0;
+        }
+        else
+        {
+            const float before = m_values[static_cast<size_t>(crossing - 1) * m_wellCount + well];
+            const float after = m_values[static_cast<size_t>(crossing) * m_wellCount + well];
+            ct[well] = crossing + interpolate(before, after, intensityThreshold, interpolation);
+        }
+    }
+}
+
+double CtEngine::findCycleThreshold(const QList<float>& intensityValues, double intensityThreshold,
+                                    Interpolation interpolation)
+{
+    const float threshold = floatThreshold(intensityThreshold);
+    for(qsizetype i = 0; i < intensityValues.size(); ++i)
+    {
+        if(intensityValues[i] < threshold) continue;
+
+        if(i == 0) return 1.0;
+        return static_cast<double>(i) + interpolate(intensityValues[i - 1], intensityValues[i],
+                                                    intensityThreshold, interpolation);
+    }
+    return -1.0;
+}
+
+float CtEngine::floatThreshold(double intensityThreshold)
+{
+    float threshold = static_cast<float>(intensityThreshold);
+    if(static_cast<double>(threshold) < intensityThreshold)
+    {
+        threshold = std::nextafter(threshold, std::numeric_limits<float>::infinity());
+    }
+    return threshold;
+}
+
+double CtEngine::interpolate(float before, float after, double intensityThreshold, Interpolation interpolation)
+{
+    // before < threshold <= after, so the bracket is never empty
+    if(interpolation == Interpolation::LogLinear && before > 0.0f)
+    {
+        const double logBefore = std::log(static_cast<double>(before));
+        return (std::log(intensityThreshold) - logBefore) / (std::log(static_cast<double>(after)) - logBefore);
+    }
+    return (intensityThreshold - before) / (static_cast<double>(after) - before);
+}
@@ -0,0 +1,82 @@
+#include "CtPredictor.hpp"
+
+#include <cmath>
+
+void CtPredictor::reset()
+{
+    *this = CtPredictor();
+}
+
+void CtPredictor::clearWindow()
+{
+    m_window.reset();
+    m_first = 0;
+}
+
+CtPrediction CtPredictor::add(int cycle, float value, const BaselineEstimate& baseline, double threshold)
+{
+    const int previousCycle = m_previousCycle;
+    const float previousValue = m_previousValue;
+    m_previousCycle = cycle;
+    m_previousValue = value;
+    if(m_prediction.crossed) return m_prediction;
+
+    if(value >= threshold)
+    {
+        m_prediction = CtPrediction();
+        m_prediction.valid = true;
+        m_prediction.crossed = true;
+        m_prediction.cycleThreshold = cycle;
+        if(previousCycle == cycle - 1 && value > previousValue)
+        {
+            m_prediction.cycleThreshold = previousCycle + (threshold - previousValue) / (value - previousValue);
+        }
+        return m_prediction;
+    }
+
+    // Until the baseline is known every reading is signal, the growth check rejects the flat start
+    const double level = baseline.valid ? baseline.valueAt(cycle) : 0.0;
+    const double noise = baseline.valid ? baseline.noise : 0.0;
+    const double signal = value - level;
+    if(signal <= MIN_SIGNAL_SIGMAS * noise || signal <= 0.0)
+    {
+        clearWindow();
+        m_prediction = CtPrediction();
+        return m_prediction;
+    }
+
+    const double logSignal = std::log(signal);
+    if(m_window.count() == WINDOW)
+    {
+        m_window.remove(m_cycles[m_first], m_logSignals[m_first]);
+        m_cycles[m_first] = cycle;
+        m_logSignals[m_first] = logSignal;
+        m_first = (m_first + 1) % WINDOW;
+    }
+    else
+    {
+        m_cycles[(m_first + m_window.count()) % WINDOW] = cycle;
+        m_logSignals[(m_first + m_window.count()) % WINDOW] = logSignal;
+    }
+    m_window.add(cycle, logSignal);
+
+    m_prediction = CtPrediction();
+    const int n = m_window.count();
+    if(n < 3 || threshold - level <= 0.0) return m_prediction;
+
+    const auto [slope, intercept, rSquared] = m_window.fit();
+    if(slope < std::log(MIN_GROWTH) || slope > std::log(MAX_GROWTH)) return m_prediction;
+
+    const double logThreshold = std::log(threshold - level);
+    const double s = std::sqrt(m_window.residualSumOfSquares() / (n - 2));
+    const double dy = logThreshold - m_window.meanY();
+    m_prediction.valid = true;
+    m_prediction.cycleThreshold = (logThreshold - intercept) / slope;
+    m_prediction.uncertainty = s / slope * std::sqrt(1.0 / n + dy * dy / (slope * slope * m_window.ssXX()));
+    return m_prediction;
+}
+
+const CtPrediction& CtPredictor::prediction() const
+{
+    return m_prediction;
+}
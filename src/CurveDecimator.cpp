@@ -0,0 +1,83 @@
+#include "CurveDecimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+std::vector<int> CurveDecimator::largestTriangleThreeBuckets(const float* x, const float* y, int count, int threshold)
+{
+    std::vector<int> kept;
+    if(count <= 0) return kept;
+    if(threshold >= count || threshold < 3)
+    {
+        kept.resize(count);
+        for(int i = 0; i < count; ++i)
+        {
+            kept[i] = i;
+        }
+        return kept;
+    }
+
+    kept.reserve(threshold);
+    kept.push_back(0);
+
+    // The first and the last point are kept as they are, the rest is split evenly
+    const double bucketSize = static_cast<double>(count - 2) / (threshold - 2);
+    int previous = 0;
+    for(int bucket = 0; bucket < threshold - 2; ++bucket)
+    {
+        const int first = static_cast<int>(bucket * bucketSize) + 1;
+        const int last = static_cast<int>((bucket + 1) * bucketSize) + 1;
+
+        // Average of the next bucket, the last point for the last bucket
+        const int nextFirst = last;
+        const int nextLast = std::min(static_cast<int>((bucket + 2) * bucketSize) + 1, count);
+        double averageX = 0.0;
+        double averageY = 0.0;
+        for(int i = nextFirst; i < nextLast; ++i)
+        {
+            averageX += x[i];
+            averageY += y[i];
+        }
+        const int nextCount = nextLast - nextFirst;
+        averageX /= nextCount;
+        averageY /= nextCount;
+
+        const double previousX = x[previous];
+        const double previousY = y[previous];
+        double largestArea = -1.0;
+        int largest = first;
+        for(int i = first; i < last; ++i)
+        {
+            // Twice the area, the factor does not change which one is largest
+            const double area = std::abs((previousX - averageX) * (y[i] - previousY) -
+                                         (previousX - x[i]) * (averageY - previousY));
+            if(area > largestArea)
+            {
+                largestArea = area;
+                largest = i;
+            }
+        }
+        kept.push_back(largest);
+        previous = largest;
+    }
+
+    kept.push_back(count - 1);
+    return kept;
+}
+
+void CurveDecimator::minMax(const float* x, const float* y, int count, int columnCount,
+                            float* minimum, float* maximum)
+{
+    constexpr float empty = std::numeric_limits<float>::quiet_NaN();
+    std::fill(minimum, minimum + columnCount, empty);
+    std::fill(maximum, maximum + columnCount, empty);
+    for(int i = 0; i < count; ++i)
+    {
+        if(!(x[i] >= 0.0f && x[i] < columnCount) || std::isnan(y[i])) continue;
+        const int column = static_cast<int>(x[i]);
+        // NaN compares false, the first point of a column always takes it
+        if(!(y[i] >= minimum[column])) minimum[column] = y[i];
+        if(!(y[i] <= maximum[column])) maximum[column] = y[i];
+    }
+}
@@ -0,0 +1,338 @@
+#include "CurveFitter.hpp"
+#include "CtEngine.hpp"
+#include "ExperimentAnalysis.hpp"
+
+#include <QSemaphore>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr int MAX_ITERATIONS = 200;
+// Stop once a step lowers the residuals by less than this fraction
+constexpr double RELATIVE_TOLERANCE = 1e-10;
+// exp() argument limit, F(x) is flat far from the midpoint anyway
+constexpr double MAX_EXPONENT = 50.0;
+
+double logisticTerm(double cycle, double midpoint, double scale)
+{
+    return std::exp(std::min(-(cycle - midpoint) / scale, MAX_EXPONENT));
+}
+
+// Solves the damped normal equations in place, only the lower triangle of a is used
+template<std::size_t N>
+bool solveCholesky(std::array<double, N * N>& a, const std::array<double, N>& b, int n, std::array<double, N>& x)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        for(int j = 0; j <= i; ++j)
+        {
+            double sum = a[i * N + j];
+            for(int k = 0; k < j; ++k)
+            {
+                sum -= a[i * N + k] * a[j * N + k];
+            }
+            if(i == j)
+            {
+                if(!(sum > 0.0)) return false;
+                a[i * N + i] = std::sqrt(sum);
+            }
+            else
+            {
+                a[i * N + j] = sum / a[j * N + j];
+            }
+        }
+    }
+
+    for(int i = 0; i < n; ++i)
+    {
+        double sum = b[i];
+        for(int k = 0; k < i; ++k)
+        {
+            sum -= a[i * N + k] * x[k];
+        }
+        x[i] = sum / a[i * N + i];
+    }
+    for(int i = n - 1; i >= 0; --i)
+    {
+        double sum = x[i];
+        for(int k = i + 1; k < n; ++k)
+        {
+            sum -= a[k * N + i] * x[k];
+        }
+        x[i] = sum / a[i * N + i];
+    }
+    return true;
+}
+
+// fallback when key is missing or not a number
+double numberValue(const fkyaml::node& node, const char* key, double fallback)
+{
+    if(!node.contains(key)) return fallback;
+    const fkyaml::node& value = node[key];
+    return value.is_integer() || value.is_float_number() ? ExperimentAnalysis::numberValue(value) : fallback;
+}
+}
+
+CurveFit CurveFitter::fit(const QList<float>& intensityValues, Model model)
+{
+    CurveFit curveFit;
+    Parameters parameters;
+    if(!initialGuess(intensityValues, parameters)) return curveFit;
+
+    double rss = 0.0;
+    int iterations = 0;
+    bool converged = levenbergMarquardt(intensityValues, 4, parameters, rss, iterations);
+    int parameterCount = 4;
+
+    // The extra parameter needs at least one more point than the 5PL has parameters
+    if(model == Model::FiveParameter && intensityValues.size() > MAX_PARAMETERS)
+    {
+        Parameters asymmetric = parameters;
+        double asymmetricRss = 0.0;
+        int asymmetricIterations = 0;
+        const bool asymmetricConverged =
+            levenbergMarquardt(intensityValues, 5, asymmetric, asymmetricRss, asymmetricIterations);
+        iterations += asymmetricIterations;
+        if(asymmetricConverged && asymmetricRss < rss)
+        {
+            parameters = asymmetric;
+            rss = asymmetricRss;
+            converged = true;
+            parameterCount = 5;
+        }
+    }
+
+    curveFit.converged = converged;
+    curveFit.parameterCount = parameterCount;
+    curveFit.baseline = parameters[0];
+    curveFit.amplitude = parameters[1];
+    curveFit.midpoint = parameters[2];
+    curveFit.scale = parameters[3];
+    curveFit.asymmetry = parameters[4];
+    curveFit.rss = rss;
+    curveFit.iterations = iterations;
+    setDerivedValues(curveFit);
+    return curveFit;
+}
+
+QList<CurveFit> CurveFitter::fitBatch(const QList<QList<float>>& curves, QThreadPool& pool, Model model)
+{
+    QList<CurveFit> fits(curves.size());
+    if(curves.isEmpty()) return fits;
+
+    // One contiguous block of curves per thread, every fit costs about the same
+    const qsizetype blockCount = std::min<qsizetype>(curves.size(), std::max(1, pool.maxThreadCount()));
+    CurveFit* results = fits.data();
+    // Counts finished blocks, waitForDone() would also wait for everything else queued on the pool
+    QSemaphore finished;
+    for(qsizetype block = 0; block < blockCount; ++block)
+    {
+        const qsizetype begin = curves.size() * block / blockCount;
+        const qsizetype end = curves.size() * (block + 1) / blockCount;
+        pool.start([&curves, &finished, results, model, begin, end]() {
+            for(qsizetype i = begin; i < end; ++i)
+            {
+                results[i] = fit(curves[i], model);
+            }
+            finished.release();
+        });
+    }
+    finished.acquire(static_cast<int>(blockCount));
+    return fits;
+}
+
+double CurveFitter::evaluate(const CurveFit& curveFit, double cycle)
+{
+    if(curveFit.parameterCount == 0) return 0.0;
+
+    const double e = logisticTerm(cycle, curveFit.midpoint, curveFit.scale);
+    return curveFit.baseline + curveFit.amplitude * std::pow(1.0 + e, -curveFit.asymmetry);
+}
+
+fkyaml::node CurveFitter::toNode(const CurveFit& curveFit)
+{
+    fkyaml::node node = fkyaml::node::mapping();
+    node["parameters"] = curveFit.parameterCount;
+    node["converged"] = curveFit.converged;
+    node["baseline"] = curveFit.baseline;
+    node["amplitude"] = curveFit.amplitude;
+    node["midpoint"] = curveFit.midpoint;
+    node["scale"] = curveFit.scale;
+    node["asymmetry"] = curveFit.asymmetry;
+    node["rss"] = curveFit.rss;
+    node["iterations"] = curveFit.iterations;
+    // Saved for other readers of the files, recomputed from the parameters on load
+    node["plateau"] = curveFit.plateau;
+    node["second_derivative_maximum"] = curveFit.secondDerivativeMaximum;
+    node["efficiency"] = curveFit.efficiency;
+    return node;
+}
+
+CurveFit CurveFitter::fromNode(const fkyaml::node& node)
+{
+    CurveFit curveFit;
+    if(!node.is_mapping()) return curveFit;
+
+    curveFit.parameterCount = static_cast<int>(numberValue(node, "parameters", 0.0));
+    if(curveFit.parameterCount != 4 && curveFit.parameterCount != 5)
+    {
+        curveFit.parameterCount = 0;
+        return curveFit;
+    }
+    curveFit.converged = node.contains("converged") && node["converged"].get_value_or<bool>(false);
+    curveFit.baseline = numberValue(node, "baseline", 0.0);
+    curveFit.amplitude = numberValue(node, "amplitude", 0.0);
+    curveFit.midpoint = numberValue(node, "midpoint", 0.0);
+    curveFit.scale = numberValue(node, "scale", 1.0);
+    curveFit.asymmetry = numberValue(node, "asymmetry", 1.0);
+    curveFit.rss = numberValue(node, "rss", 0.0);
+    curveFit.iterations = static_cast<int>(numberValue(node, "iterations", 0.0));
+    setDerivedValues(curveFit);
+    return curveFit;
+}
+
+bool CurveFitter::initialGuess(const QList<float>& intensityValues, Parameters& parameters)
+{
+    if(intensityValues.size() <= 4) return false;
+
+    const auto [minimum, maximum] = std::minmax_element(intensityValues.begin(), intensityValues.end());
+    const double baseline = *minimum;
+    const double amplitude = static_cast<double>(*maximum) - baseline;
+    if(!std::isfinite(amplitude) || amplitude <= 0.0) return false;
+
+    // Midpoint and steepness from where the curve crosses 25%, 50% and 75% of its rise
+    const double lower = CtEngine::findCycleThreshold(intensityValues, baseline + 0.25 * amplitude);
+    const double middle = CtEngine::findCycleThreshold(intensityValues, baseline + 0.5 * amplitude);
+    const double upper = CtEngine::findCycleThreshold(intensityValues, baseline + 0.75 * amplitude);
+
+    // x75 - x25 = 2 b ln 3 for the logistic
+    parameters = {baseline, amplitude, middle, std::max((upper - lower) / (2.0 * std::log(3.0)), 0.25), 1.0};
+    return true;
+}
+
+bool CurveFitter::levenbergMarquardt(const QList<float>& intensityValues, int parameterCount,
+                                     Parameters& parameters, double& rss, int& iterations)
+{
+    std::array<double, MAX_PARAMETERS * MAX_PARAMETERS> jtj{};
+    std::array<double, MAX_PARAMETERS * MAX_PARAMETERS> damped{};
+    Parameters jtr{};
+    Parameters row{};
+    Parameters step{};
+    Parameters trial{};
+
+    double lambda = 1e-3;
+    bool accumulate = true;
+    rss = residualSumOfSquares(intensityValues, parameters);
+    for(iterations = 0; iterations < MAX_ITERATIONS; ++iterations)
+    {
+        if(accumulate)
+        {
+            const auto [baseline, amplitude, midpoint, scale, asymmetry] = parameters;
+            jtj.fill(0.0);
+            jtr.fill(0.0);
+            for(qsizetype i = 0; i < intensityValues.size(); ++i)
+            {
+                const double cycle = static_cast<double>(i + 1);
+                const double e = logisticTerm(cycle, midpoint, scale);
+                const double u = 1.0 + e;
+                const double s = std::pow(u, -asymmetry);
+                const double dMidpoint = -amplitude * asymmetry * e * s / (u * scale);
+
+                row[0] = 1.0;
+                row[1] = s;
+                row[2] = dMidpoint;
+                row[3] = dMidpoint * (cycle - midpoint) / scale;
+                row[4] = -amplitude * s * std::log(u);
+
+                const double residual = intensityValues[i] - (baseline + amplitude * s);
+                for(int a = 0; a < parameterCount; ++a)
+                {
+                    jtr[a] += row[a] * residual;
+                    for(int b = 0; b <= a; ++b)
+                    {
+                        jtj[a * MAX_PARAMETERS + b] += row[a] * row[b];
+                    }
+                }
+            }
+            accumulate = false;
+        }
+
+        damped = jtj;
+        for(int a = 0; a < parameterCount; ++a)
+        {
+            damped[a * MAX_PARAMETERS + a] += lambda * std::max(jtj[a * MAX_PARAMETERS + a], 1e-12);
+        }
+
+        double trialRss = std::numeric_limits<double>::infinity();
+        if(solveCholesky<MAX_PARAMETERS>(damped, jtr, parameterCount, step))
+        {
+            trial = parameters;
+            for(int a = 0; a < parameterCount; ++a)
+            {
+                trial[a] += step[a];
+            }
+            if(isValid(trial))
+            {
+                trialRss = residualSumOfSquares(intensityValues, trial);
+            }
+        }
+
+        if(trialRss < rss)
+        {
+            const double improvement = (rss - trialRss) / std::max(rss, std::numeric_limits<double>::min());
+            parameters = trial;
+            rss = trialRss;
+            lambda = std::max(lambda / 10.0, 1e-12);
+            accumulate = true;
+            if(improvement < RELATIVE_TOLERANCE) return true;
+        }
+        else
+        {
+            // No step downhill left however short it is, the fit sits at a minimum
+            lambda *= 10.0;
+            if(lambda > 1e10) return true;
+        }
+    }
+    return false;
+}
+
+double CurveFitter::residualSumOfSquares(const QList<float>& intensityValues, const Parameters& parameters)
+{
+    const auto [baseline, amplitude, midpoint, scale, asymmetry] = parameters;
+    double rss = 0.0;
+    for(qsizetype i = 0; i < intensityValues.size(); ++i)
+    {
+        const double e = logisticTerm(static_cast<double>(i + 1), midpoint, scale);
+        const double residual = intensityValues[i] - (baseline + amplitude * std::pow(1.0 + e, -asymmetry));
+        rss += residual * residual;
+    }
+    return rss;
+}
+
+bool CurveFitter::isValid(const Parameters& parameters)
+{
+    for(double parameter : parameters)
+    {
+        if(!std::isfinite(parameter)) return false;
+    }
+    // A falling or vertical curve is no amplification, extreme asymmetry is a degenerate fit
+    return parameters[1] > 0.0 && parameters[3] > 1e-3 && parameters[4] > 0.01 && parameters[4] < 100.0;
+}
+
+void CurveFitter::setDerivedValues(CurveFit& curveFit)
+{
+    if(curveFit.parameterCount == 0) return;
+
+    const double g = curveFit.asymmetry;
+    const double b = curveFit.scale;
+    curveFit.plateau = curveFit.baseline + curveFit.amplitude;
+
+    const double peak = ((3.0 * g + 1.0) + std::sqrt((3.0 * g + 1.0) * (3.0 * g + 1.0) - 4.0 * g * g)) / (2.0 * g * g);
+    curveFit.secondDerivativeMaximum = curveFit.midpoint - b * std::log(peak);
+
+    // F(Cq - 1) has e* exp(1 / b) in place of e*
+    const double previous = peak * std::exp(std::min(1.0 / b, MAX_EXPONENT));
+    curveFit.efficiency = (std::pow((1.0 + previous) / (1.0 + peak), g) - 1.0) * 100.0;
+}
@@ -1,17 +1,53 @@
 #include <QDebug>
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <QDir>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 
 #include "DataManager.hpp"
+#include "ExperimentAnalysis.hpp"
 
-DataManager::DataManager(QMap<QString, fkyaml::node>& experiments)
+namespace {
+bool byLogConcentration(const QPair<double, double>& a, const QPair<double, double>& b)
+{
+    return a.first < b.first;
+}
+
+void setReplicate(ReplicateGroups& groups, const QString& experimentName, const QString& group,
+                  const QString& sampleType, double concentration, double cycleThreshold)
+{
+    // A run that has not crossed yet, or not run at all, has no Ct to average
+    if(cycleThreshold <= 0.0)
+    {
+        groups.remove(experimentName);
+        return;
+    }
+    // Same log concentration setCycleThreshold puts on the standard curve, none without a positive concentration
+    const double logConcentration = concentration > 0.0 ? std::log10(concentration)
+                                                        : std::numeric_limits<double>::quiet_NaN();
+    groups.set(experimentName, group, sampleType == "unknown", logConcentration, cycleThreshold);
+}
+}
+
+DataManager::DataManager(QMap<QString, fkyaml::node>& experiments, QSharedPointer<ExperimentArchive> archive)
     : m_experiments{experiments},
+    m_archive{archive},
     m_currentIntensityValuesIndex{0},
-    m_cycleThreshold{0},
+    m_cycleThreshold{0.0},
+    m_autoThreshold{false},
+    m_autoThresholdDelta{0.0},
+    m_meltEnabled{false},
+    m_meltingTemperature{0.0},
+    m_earlyStop{false},
+    m_predictedCt{-1.0},
+    m_predictedCtUncertainty{0.0},
+    m_sampleType{"standard"},
     m_ledIntensity{0},
     m_maxCycle{0},
     m_currentExperimentName{""},
@@ -24,16 +60,31 @@ DataManager::DataManager(QMap<QString, fkyaml::node>& experiments)
     m_lastSaved{""},
     m_summary{"The resulting data are not reliable for quantification."}
 {
+    m_bootstrapRunner.setMaxThreadCount(1);
+
     for(const auto& [experimentName, value] : m_experiments.asKeyValueRange())
     {
         m_experimentNames.push_back(experimentName);
     }
 
+    // Archived experiments stay selectable, they are only parsed once opened
+    if (m_archive) {
+        for(const auto& experimentName : m_archive->archivedNames())
+        {
+            if (!m_experiments.contains(experimentName)) {
+                m_experimentNames.push_back(experimentName);
+            }
+        }
+        std::sort(m_experimentNames.begin(), m_experimentNames.end());
+    }
+
     if (m_experimentNames.isEmpty()) {
         qDebug() << "No experiments found on startup. Creating 'new_experiment.yml'...";
         createExperimentFromTemplate("new_experiment.yml");
     }
 
+    rebuildReplicateGroups();
+
     // Safety: Ensure we have a valid current name
     if (m_currentExperimentName.isEmpty() && !m_experimentNames.isEmpty()) {
         m_currentExperimentName = m_experimentNames.first();
@@ -84,7 +135,7 @@ void DataManager::save_data()
     sequence.clear();
     for(int i = 0; i<m_maxCycle; ++i)
     {
-        sequence.push_back(m_intensityValues[i]);
+        sequence.push_back(ExperimentAnalysis::toStoredValue(m_intensityValues[i]));
     }
 
     auto& curve_points = m_currentExperiment["standard_curve_points"].as_seq();
@@ -96,125 +147,318 @@ void DataManager::save_data()
 
     // Write to the file
     ofs << m_currentExperiment;
+    ofs.close();
+    emit experimentSaved(m_currentExperimentName);
 }
 
-std::tuple<double, double, double>
-DataManager::simpleLinearRegression(const std::vector<double>& x, const std::vector<double>& y) {
-    if (x.size() != y.size() || x.empty()) return {0.0, 0.0, 0.0};
+void DataManager::calculateStandardCurve()
+{
+    ++m_standardCurveGeneration;
+    if(m_xyLogStandardCurve.size() < 5) {
+        m_rSquared = 0.0f;
+        m_yIntercept = 0.0f;
+        m_slope = 0.0f;
+        m_percentEfficiency = 0.0f;
+        m_cycleThreshold = 0;
+        m_robustFit = RobustFit();
+        m_standardCurveIntervals = StandardCurveIntervals();
+        emit standardCurveIntervalsChanged();
+        emit standardCurveFitChanged();
+        m_summary = standardCurveSummary(m_xyLogStandardCurve.size(), 0.0);
+        return;
+    }
 
-    size_t n = x.size();
-    if (n < 2) return {0.0, 0.0, 0.0}; // Need at least 2 points
+    // The reported curve and its verdict are the ordinary fit over every point. The robust fit is shown next to it
+    // and flags the points that look like outliers, leaving them out silently would let a curve pass on fewer
+    // points than it has
+    auto [slope, intercept, r_squared] = m_regression.fit();
+    double efficiency = ExperimentAnalysis::calculatePCREfficiency(slope);
+    m_robustFit = RobustRegression::fit(m_xyLogStandardCurve, m_regression);
 
-    // Compute Means (Averages)
-    // This centers the data, keeping numbers smaller to avoid overflow.
-    double sum_x = 0.0;
-    double sum_y = 0.0;
-    for (size_t i = 0; i < n; ++i) {
-        sum_x += x[i];
-        sum_y += y[i];
+    m_slope = slope;
+    m_yIntercept = intercept;
+    m_rSquared = r_squared;
+    m_percentEfficiency = efficiency;
+    m_summary = standardCurveSummary(m_xyLogStandardCurve.size(), m_rSquared);
+    emit standardCurveFitChanged();
+
+    startStandardCurveBootstrap();
+
+    // Fewer than 2 points left after outlier rejection, or no two different concentrations
+    if(m_robustFit.weights.isEmpty()) return;
+    // Same as the ordinary fit on clean data, outliers get no weight and far points less
+    m_summary += QString("\nRobust fit: slope %1, R² %2, efficiency %3%")
+                     .arg(m_robustFit.slope, 0, 'f', 3)
+                     .arg(m_robustFit.rSquared, 0, 'f', 4)
+                     .arg(ExperimentAnalysis::calculatePCREfficiency(m_robustFit.slope), 0, 'f', 1);
+
+    if(m_robustFit.outlierCount() == 0) return;
+    m_summary += QString("\n%1 possible outlier(s), remove them to refit without them:")
+                     .arg(m_robustFit.outlierCount());
+    for(qsizetype i = 0; i < m_xyLogStandardCurve.size(); ++i)
+    {
+        if(!m_robustFit.outliers[i]) continue;
+        m_summary += QString("\n  log concentration %1, Ct %2 (R² without it: %3)")
+                         .arg(m_xyLogStandardCurve[i].first)
+                         .arg(m_xyLogStandardCurve[i].second, 0, 'f', 2)
+                         .arg(m_robustFit.leaveOneOutRSquared[i], 0, 'f', 4);
     }
-    double mean_x = sum_x / n;
-    double mean_y = sum_y / n;
+}
 
-    // Compute Variance & Covariance
-    // We sum the differences from the mean, rather than raw squares.
-    // This prevents Catastrophic Cancellation.
-    double ss_xx = 0.0; // Sum of squares (x - mean_x)
-    double ss_yy = 0.0; // Sum of squares (y - mean_y)
-    double ss_xy = 0.0; // Sum of products (x - mean_x)*(y - mean_y)
+void DataManager::startStandardCurveBootstrap()
+{
+    // The intervals of the previous curve no longer apply, they are empty until the resamples are in
+    const quint64 generation = m_standardCurveGeneration;
+    m_standardCurveIntervals = StandardCurveIntervals();
+    emit standardCurveIntervalsChanged();
+
+    auto* watcher = new QFutureWatcher<StandardCurveIntervals>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, generation]() {
+        watcher->deleteLater();
+        // The curve was refitted while this one was resampled
+        if(generation != m_standardCurveGeneration) return;
+
+        m_standardCurveIntervals = watcher->result();
+        emit standardCurveIntervalsChanged();
+        if(!m_standardCurveIntervals.valid) return;
+
+        // 90-110% is the usual acceptance range for a standard curve
+        const ConfidenceInterval& efficiency = m_standardCurveIntervals.efficiency;
+        m_summary += QString("\nEfficiency 95% CI: %1 - %2% (%3)")
+                         .arg(efficiency.lower, 0, 'f', 1)
+                         .arg(efficiency.upper, 0, 'f', 1)
+                         .arg(efficiency.lower >= 90.0 && efficiency.upper <= 110.0
+                                  ? "within 90 - 110%" : "not within 90 - 110%");
+        emit summaryChanged();
+    });
+    watcher->setFuture(QtConcurrent::run(&m_bootstrapRunner,
+                                         [this, points = m_xyLogStandardCurve, generation]() {
+        // Still queued behind a bootstrap when the curve was refitted again, its result would be dropped
+        if(generation != m_standardCurveGeneration) return StandardCurveIntervals();
+        return StandardCurveBootstrap::compute(points, m_bootstrapPool);
+    }));
+}
 
-    for (size_t i = 0; i < n; ++i) {
-        double dx = x[i] - mean_x;
-        double dy = y[i] - mean_y;
+void DataManager::removeStandardCurvePoint(int index)
+{
+    if(index < 0 || index >= m_xyLogStandardCurve.size()) return;
 
-        ss_xx += dx * dx;
-        ss_yy += dy * dy;
-        ss_xy += dx * dy;
-    }
+    const auto point = m_xyLogStandardCurve.takeAt(index);
+    m_regression.remove(point.first, point.second);
+    emit standardCurvePointRemoved(index);
+    calculateStandardCurve();
+}
 
-    // If ss_xx is 0, all X values are identical (vertical line).
-    if (std::abs(ss_xx) < 1e-9) return {0.0, 0.0, 0.0};
+void DataManager::estimateBaseline()
+{
+    updateBaseline(m_intensityValues.size());
+}
 
-    double slope = ss_xy / ss_xx;
-    double intercept = mean_y - slope * mean_x;
+void DataManager::updateBaseline(int sampleCount)
+{
+    if(!m_autoThreshold) return;
 
-    // R^2 = (Covariance / (StdDev_X * StdDev_Y))^2
-    double r_squared = 0.0;
-    if (ss_yy > 1e-9) {
-        // Mathematically equivalent to: (ss_xy * ss_xy) / (ss_xx * ss_yy)
-        // Calculated this way to preserve sign/precision logic
-        double r = ss_xy / std::sqrt(ss_xx * ss_yy);
-        r_squared = r * r;
-    }
+    m_baseline = BaselineEstimator::estimate(m_intensityValues, sampleCount);
+    // Too few readings yet, keep the previous threshold
+    if(!m_baseline.valid) return;
 
-    return {slope, intercept, r_squared};
+    m_autoThresholdDelta = m_baseline.threshold;
+    emit autoThresholdDeltaChanged();
 }
 
-double DataManager::calculatePCREfficiency(double slope) {
-    // Prevent division by zero
-    // A slope of 0 means Ct never changes regardless of dilution (impossible/bad data).
-    if (std::abs(slope) < 1e-9) {
-        return std::numeric_limits<double>::infinity();
+void DataManager::quantifyUnknowns()
+{
+    // Same 5 point minimum as the reported curve
+    const CalibrationCurve curve = m_xyLogStandardCurve.size() < 5 ? CalibrationCurve()
+                                                                   : Quantification::calibrationCurve(m_regression);
+    if(!curve.valid)
+    {
+        m_quantification = "No standard curve to quantify unknown samples against.";
+        emit quantificationChanged();
+        return;
     }
 
-    double exponent = -1.0 / slope;
+    // Ct of every unknown by name. The current experiment may have unsaved changes, its members are used
+    // instead of its node
+    QMap<QString, double> unknowns;
+    for(const auto& [experimentName, root] : std::as_const(m_experiments).asKeyValueRange())
+    {
+        if(experimentName == m_currentExperimentName)
+        {
+            if(m_sampleType == "unknown") unknowns.insert(experimentName, m_cycleThreshold);
+            continue;
+        }
+        try {
+            const ExperimentMetadata metadata = ExperimentMetadataReader::fromNode(root);
+            if(metadata.sampleType == "unknown") unknowns.insert(experimentName, metadata.cycleThreshold);
+        } catch (const fkyaml::exception& e) {
+            qWarning() << "DataManager: not quantifying" << experimentName << "-" << e.what();
+        }
+    }
+    // Archived experiments are not parsed, their index entry has the type and Ct, like in rebuildReplicateGroups
+    if (m_archive) {
+        for(const auto& [experimentName, entry] : m_archive->entries().asKeyValueRange())
+        {
+            if (m_experiments.contains(experimentName) || entry.sampleType != "unknown") continue;
+            unknowns.insert(experimentName, entry.cycleThreshold);
+        }
+    }
 
-    // std::pow(10, x) will overflow 'double' if x > ~308.
-    // This happens if the slope is extremely small (e.g., -0.000001).
-    if (exponent > 308.0) {
-        return std::numeric_limits<double>::infinity();
+    const QList<QString> names = unknowns.keys();
+    std::vector<double> cycleThresholds;
+    cycleThresholds.reserve(unknowns.size());
+    for(double cycleThreshold : std::as_const(unknowns))
+    {
+        // 0 is a run that has not run yet, quantifyBatch only knows negative Ct as missing
+        cycleThresholds.push_back(cycleThreshold > 0.0 ? cycleThreshold : -1.0);
     }
 
-    // Calculate Efficiency
-    // Subtract 1 to get the efficiency fraction, multiply by 100 for percentage.
-    return (std::pow(10.0, exponent) - 1.0) * 100.0;
+    std::vector<double> logQuantities(cycleThresholds.size());
+    std::vector<double> halfWidths(cycleThresholds.size());
+    Quantification::quantifyBatch(curve, cycleThresholds.data(), cycleThresholds.size(),
+                                  logQuantities.data(), halfWidths.data());
+
+    m_quantification = names.isEmpty() ? "No unknown samples." : "Unknown samples (95% CI):";
+    for(qsizetype i = 0; i < names.size(); ++i)
+    {
+        m_quantification += "\n" + names[i].chopped(4) + ": ";
+        if(std::isnan(logQuantities[i]))
+        {
+            m_quantification += "no Ct";
+            continue;
+        }
+        const Quantity quantity{true, logQuantities[i], halfWidths[i]};
+        m_quantification += QString("%1 (%2 – %3)")
+                                .arg(quantity.quantity(), 0, 'g', 3)
+                                .arg(quantity.lower(), 0, 'g', 3)
+                                .arg(quantity.upper(), 0, 'g', 3);
+    }
+    emit quantificationChanged();
 }
 
-void DataManager::calculateStandardCurve()
+void DataManager::useReplicateMeans()
 {
-    if(m_xyLogStandardCurve.size() < 5) {
-        m_rSquared = 0.0f;
-        m_yIntercept = 0.0f;
-        m_slope = 0.0f;
-        m_percentEfficiency = 0.0f;
-        m_cycleThreshold = 0;
-        m_summary = "You need at least 5 dilution points.";
-        return;
+    const QList<QPair<double, double>> points = m_replicateGroups.groupMeans();
+    RegressionAccumulator regression;
+    for(const auto& [x, y] : points)
+    {
+        regression.add(x, y);
     }
+    setStandardCurve(points, regression);
+}
 
-    std::vector<double> x, y;
-    for(int i=0; i<m_xyLogStandardCurve.size(); ++i)
+void DataManager::buildStandardCurve(const QStringList& experimentNames)
+{
+    QList<ExperimentMetadata> runs;
+    runs.reserve(experimentNames.size());
+    for(const auto& experimentName : experimentNames)
     {
-        x.push_back(m_xyLogStandardCurve[i].first);
-        y.push_back(m_xyLogStandardCurve[i].second);
+        try {
+            runs.push_back(metadataOf(experimentName));
+        } catch (const fkyaml::exception& e) {
+            qWarning() << "DataManager: leaving" << experimentName << "out of the standard curve -" << e.what();
+        }
     }
 
-    auto [slope, intercept, r_squared] = simpleLinearRegression(x, y);
-    double efficiency = calculatePCREfficiency(slope);
+    const StandardCurveBuild build = StandardCurveBuilder::build(runs);
+    setStandardCurve(build.points, build.regression);
+    const qsizetype skipped = build.skipped + experimentNames.size() - runs.size();
+    if(skipped > 0)
+    {
+        m_summary += QString("\n%1 selected experiment(s) without a standard Ct and concentration left out.").arg(skipped);
+        emit summaryChanged();
+    }
+}
 
-    m_slope = slope;
-    m_yIntercept = intercept;
-    m_rSquared = r_squared;
-    m_percentEfficiency = efficiency;
+ExperimentMetadata DataManager::metadataOf(const QString& experimentName) const
+{
+    if(experimentName == m_currentExperimentName)
+    {
+        // May have unsaved changes, like quantifyUnknowns the members win over the node
+        ExperimentMetadata metadata;
+        metadata.experimentName = m_currentExperimentName.chopped(4);
+        metadata.lastSaved = QString::fromStdString(m_lastSaved);
+        metadata.rSquared = m_rSquared;
+        metadata.efficiency = m_percentEfficiency;
+        metadata.replicateGroup = m_replicateGroup;
+        metadata.sampleType = m_sampleType;
+        metadata.cycleThreshold = m_cycleThreshold;
+        metadata.concentration = static_cast<double>(m_concentrationCoefficient.toFloat()) *
+                                 static_cast<double>(m_concentrationMultiplier);
+        return metadata;
+    }
 
-    if(m_rSquared >= 0.98)
+    const auto experiment = m_experiments.constFind(experimentName);
+    if(experiment != m_experiments.constEnd()) return ExperimentMetadataReader::fromNode(*experiment);
+    if(m_archive && m_archive->contains(experimentName)) return m_archive->metadata(experimentName);
+    return ExperimentMetadata();
+}
+
+void DataManager::setStandardCurve(const QList<QPair<double, double>>& points, const RegressionAccumulator& regression)
+{
+    m_xyLogStandardCurve = points;
+    m_regression = regression;
+    calculateStandardCurve();
+
+    emit rSquaredChanged();
+    emit yInterceptChanged();
+    emit slopeChanged();
+    emit percentEfficiencyChanged();
+    emit summaryChanged();
+    emit xyLogStandardCurveUpdated();
+}
+
+void DataManager::rebuildReplicateGroups()
+{
+    m_replicateGroups.clear();
+    for(const auto& [experimentName, root] : m_experiments.asKeyValueRange())
     {
-        m_summary = "The resulting data are reliable for quantification.";
+        try {
+            const ExperimentMetadata metadata = ExperimentMetadataReader::fromNode(root);
+            setReplicate(m_replicateGroups, experimentName, metadata.replicateGroup, metadata.sampleType,
+                         metadata.concentration, metadata.cycleThreshold);
+        } catch (const fkyaml::exception& e) {
+            qWarning() << "DataManager: no replicate statistics for" << experimentName << "-" << e.what();
+        }
     }
-    else
+
+    // Archived experiments are counted from the index, they stay compressed
+    if (!m_archive) return;
+    for(const auto& [experimentName, entry] : m_archive->entries().asKeyValueRange())
     {
-        m_summary = "The resulting data are not reliable for quantification.";
+        if (m_experiments.contains(experimentName)) continue;
+        setReplicate(m_replicateGroups, experimentName, entry.replicateGroup, entry.sampleType,
+                     entry.concentration, entry.cycleThreshold);
     }
+}
 
+QString DataManager::standardCurveSummary(int pointCount, double rSquared)
+{
+    if(pointCount < 5)
+    {
+        return "You need at least 5 dilution points.";
+    }
+
+    if(rSquared >= 0.98)
+    {
+        return "The resulting data are reliable for quantification.";
+    }
+    return "The resulting data are not reliable for quantification.";
 }
 
 void DataManager::resetIntensityValues()
 {
     m_currentIntensityValuesIndex = 0;
+    m_plateauDetector.reset();
+    m_ctPredictor.reset();
+    m_predictedCt = -1.0;
+    m_predictedCtUncertainty = 0.0;
+    emit predictedCtChanged();
     for(uint8_t i = 0; i < m_intensityValues.size(); ++i)
     {
         m_intensityValues[i] = 0.0f;
     }
+    emit intensityValuesReset();
 }
 
 void DataManager::resetStandardCurveData()
@@ -225,7 +469,10 @@ void DataManager::resetStandardCurveData()
     m_percentEfficiency = 0.0f;
     m_summary = "";
     m_cycleThreshold = 0;
+    m_curveFit = CurveFit();
     m_xyLogStandardCurve.clear();
+    m_regression.reset();
+    emit xyLogStandardCurveUpdated();
     calculateStandardCurve();
 }
 
@@ -234,7 +481,7 @@ void DataManager::setIntensityValuesSize(int size)
     m_intensityValues.resize(size);
 }
 
-QList<QPair<double, int>>& DataManager::getXyLogStandardCurve()
+QList<QPair<double, double>>& DataManager::getXyLogStandardCurve()
 {
     return m_xyLogStandardCurve;
 }
@@ -249,6 +496,74 @@ int DataManager::getStandardCurveDataSize() const
     return m_xyLogStandardCurve.size();
 }
 
+double DataManager::slopeLower() const
+{
+    return m_standardCurveIntervals.slope.lower;
+}
+
+double DataManager::slopeUpper() const
+{
+    return m_standardCurveIntervals.slope.upper;
+}
+
+double DataManager::interceptLower() const
+{
+    return m_standardCurveIntervals.intercept.lower;
+}
+
+double DataManager::interceptUpper() const
+{
+    return m_standardCurveIntervals.intercept.upper;
+}
+
+double DataManager::efficiencyLower() const
+{
+    return m_standardCurveIntervals.efficiency.lower;
+}
+
+double DataManager::efficiencyUpper() const
+{
+    return m_standardCurveIntervals.efficiency.upper;
+}
+
+int DataManager::replicateCount() const
+{
+    return m_replicateGroups.statistics(m_replicateGroup).count;
+}
+
+double DataManager::replicateMeanCt() const
+{
+    return m_replicateGroups.statistics(m_replicateGroup).meanCycleThreshold;
+}
+
+double DataManager::replicateSd() const
+{
+    return m_replicateGroups.statistics(m_replicateGroup).standardDeviation();
+}
+
+double DataManager::replicateCv() const
+{
+    return m_replicateGroups.statistics(m_replicateGroup).coefficientOfVariation();
+}
+
+QString DataManager::replicateSummary() const
+{
+    const auto& groups = m_replicateGroups.groups();
+    if(groups.isEmpty()) return "No replicate groups.";
+
+    QString summary = "Replicate groups (Ct mean ± SD, CV):";
+    for(const auto& [group, statistics] : groups.asKeyValueRange())
+    {
+        summary += QString("\n%1: n = %2, %3 ± %4, %5%")
+                       .arg(group)
+                       .arg(statistics.count)
+                       .arg(statistics.meanCycleThreshold, 0, 'f', 2)
+                       .arg(statistics.standardDeviation(), 0, 'f', 2)
+                       .arg(statistics.coefficientOfVariation(), 0, 'f', 1);
+    }
+    return summary;
+}
+
 float DataManager::getConcentrationMultiplier() const
 {
     return m_concentrationMultiplier;
@@ -301,19 +616,69 @@ void DataManager::addSensorReading(float lux)
     // -- Update the current index and cycle through 0-30
     try {
         updateSensorReading(lux);
+        updateBaseline(m_currentIntensityValuesIndex + 1);
+
+        // An automatic threshold is measured above the baseline, the detector needs it in lux
+        const double threshold = m_autoThreshold && m_baseline.valid
+                                     ? m_baseline.valueAt(m_currentIntensityValuesIndex + 1) + m_autoThresholdDelta
+                                     : m_intensityThreshold;
+        // The prediction extrapolates the signal above the baseline, which a manual threshold does not need
+        const BaselineEstimate baseline = m_autoThreshold
+                                              ? m_baseline
+                                              : BaselineEstimator::estimate(m_intensityValues, m_currentIntensityValuesIndex + 1);
+        const CtPrediction prediction = m_ctPredictor.add(m_currentIntensityValuesIndex + 1, lux, baseline, threshold);
+        m_predictedCt = prediction.valid ? prediction.cycleThreshold : -1.0;
+        m_predictedCtUncertainty = prediction.uncertainty;
+        m_updates.markSignal(this, &DataManager::predictedCtChanged);
+
+        const bool wasPlateaued = m_plateauDetector.plateaued();
+        if(m_plateauDetector.addReading(lux, threshold) && !wasPlateaued && m_earlyStop)
+        {
+            qDebug() << "DataManager: plateau reached at cycle" << m_plateauDetector.plateauCycle();
+            emit plateauReached();
+        }
         /**
         * Move to next index, cycle back to 0 after 30
         * This acts as a foolproof so long as list is capped,
         * though sensor reads only until 30 (HardwareController)
         */
         m_currentIntensityValuesIndex = (m_currentIntensityValuesIndex + 1) % m_intensityValues.size();
-        emit currentIntensityValuesIndexChanged(m_currentIntensityValuesIndex);
+        m_updates.markSignal(this, &DataManager::currentIntensityValuesIndexChanged, m_currentIntensityValuesIndex);
 
     } catch (const std::runtime_error& e) {
         qFatal("DataManager: Fatal error - %s", e.what());
     }
 }
 
+void DataManager::setStopReason(const QString& stopReason)
+{
+    m_stopReason = stopReason;
+    updateStopReason();
+    emit stopReasonChanged();
+}
+
+void DataManager::resetMeltCurve()
+{
+    m_meltAnalyzer.reset();
+    m_meltingTemperature = 0.0;
+    emit meltingTemperatureChanged();
+    emit meltCurveUpdated();
+}
+
+void DataManager::addMeltSample(float temperature, float lux)
+{
+    m_meltAnalyzer.add(temperature, lux);
+}
+
+void DataManager::finishMeltCurve()
+{
+    m_meltAnalyzer.finish();
+    m_meltingTemperature = m_meltAnalyzer.curve().meltingTemperature();
+    updateMeltCurve();
+    emit meltingTemperatureChanged();
+    emit meltCurveUpdated();
+}
+
 int DataManager::getCurrentIntensityValuesIndex() const
 {
     return m_currentIntensityValuesIndex;
@@ -354,18 +719,31 @@ QString DataManager::getCurrTimeStampStr()
 
 void DataManager::setCycleThreshold()
 {
-    m_cycleThreshold = -1;
-    for(size_t i = 0; i < m_intensityValues.size(); ++i)
+    AnalysisSettings settings;
+    settings.intensityThreshold = m_intensityThreshold;
+    settings.autoThreshold = m_autoThreshold;
+    const AnalysisResult result = ExperimentAnalysis::analyze(m_intensityValues, settings);
+
+    m_baseline = result.baseline;
+    // The manual threshold stays as the user set it, only the automatic delta follows the run
+    if(result.baseline.valid && result.intensityThreshold != m_autoThresholdDelta)
     {
-        if (m_intensityValues[i] >= m_intensityThreshold)
-        {
-            m_cycleThreshold = i + 1;
-            break;
-        }
+        m_autoThresholdDelta = result.intensityThreshold;
+        emit autoThresholdDeltaChanged();
     }
+    m_cycleThreshold = result.cycleThreshold;
+    emit cycleThresholdChanged();
+    m_curveFit = result.curveFit;
     // Do not add point to the curve if no intensity that is higher than intensity threshold
-    if(m_cycleThreshold == -1) return;
+    if(m_cycleThreshold < 0.0) return;
+    // An unknown is quantified against the curve, its concentration is what is being measured
+    if(m_sampleType == "unknown") return;
+
+    insertStandardCurvePoint(runPoint());
+}
 
+QPair<double, double> DataManager::runPoint() const
+{
     auto coeff = m_concentrationCoefficient.toFloat();
     auto multiplier = m_concentrationMultiplier;
 
@@ -385,9 +763,59 @@ void DataManager::setCycleThreshold()
         qWarning() << "Cannot calculate log of non-positive concentration:" << concentration;
     }
 
-    auto x = logConcentration;
-    auto y = m_cycleThreshold;
-    m_xyLogStandardCurve.push_back(std::make_pair(x, y));
+    return qMakePair(logConcentration, m_cycleThreshold);
+}
+
+void DataManager::insertStandardCurvePoint(const QPair<double, double>& point)
+{
+    const auto position = std::upper_bound(m_xyLogStandardCurve.begin(), m_xyLogStandardCurve.end(),
+                                           point, byLogConcentration);
+    const int index = static_cast<int>(position - m_xyLogStandardCurve.begin());
+    m_xyLogStandardCurve.insert(position, point);
+    m_regression.add(point.first, point.second);
+    emit standardCurvePointInserted(index);
+}
+
+int DataManager::standardCurvePointIndex(const QPair<double, double>& point) const
+{
+    // A concentration loaded from a file went through text, so the match allows for rounding
+    for(qsizetype i = 0; i < m_xyLogStandardCurve.size(); ++i)
+    {
+        if(std::abs(m_xyLogStandardCurve[i].first - point.first) < 1e-6 &&
+           std::abs(m_xyLogStandardCurve[i].second - point.second) < 1e-6)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void DataManager::setSampleType(const QString& sampleType)
+{
+    if(sampleType == m_sampleType) return;
+
+    m_sampleType = sampleType;
+    emit sampleTypeChanged();
+
+    // Only a run that crossed the threshold has a point on the curve
+    if(m_cycleThreshold <= 0.0) return;
+
+    // The point a finished run added as a standard leaves the curve when it turns out to be an unknown,
+    // and comes back when it is switched back
+    const QPair<double, double> point = runPoint();
+    const int index = standardCurvePointIndex(point);
+    if(m_sampleType == "unknown")
+    {
+        if(index >= 0)
+        {
+            removeStandardCurvePoint(index);
+        }
+    }
+    else if(index < 0)
+    {
+        insertStandardCurvePoint(point);
+        calculateStandardCurve();
+    }
 }
 
 int DataManager::getInitialLedIntensityValue()
@@ -410,10 +838,17 @@ void DataManager::updateCurrentExperiment()
     updateLedIntensity();
     updateMaxCycle();
     updateIntensityThreshold();
+    updateAutoThreshold();
+    updateAutoThresholdDelta();
+    updateMeltEnabled();
+    updateEarlyStop();
     updateCycleThreshold();
     updateConcentrationCoefficient();
     updateConcentrationMultiplier();
+    updateSampleType();
+    updateReplicateGroup();
     updateXYStandardCurve();
+    updateReplicateStatistics();
 }
 
 void DataManager::updateLedIntensity()
@@ -434,10 +869,47 @@ void DataManager::updateIntensityThreshold()
     currentExperiment["intensity_threshold"] = m_intensityThreshold;
 }
 
+void DataManager::updateAutoThreshold()
+{
+    auto& currentExperiment = m_experiments[m_currentExperimentName];
+    currentExperiment["auto_threshold"] = m_autoThreshold;
+}
+
+void DataManager::updateAutoThresholdDelta()
+{
+    auto& currentExperiment = m_experiments[m_currentExperimentName];
+    currentExperiment["auto_threshold_delta"] = m_autoThresholdDelta;
+}
+
+void DataManager::updateMeltEnabled()
+{
+    auto& currentExperiment = m_experiments[m_currentExperimentName];
+    currentExperiment["melt_enabled"] = m_meltEnabled;
+}
+
+void DataManager::updateMeltCurve()
+{
+    auto& currentExperiment = m_experiments[m_currentExperimentName];
+    currentExperiment["melt_curve"] = MeltAnalyzer::toNode(m_meltAnalyzer.curve());
+}
+
+void DataManager::updateEarlyStop()
+{
+    auto& currentExperiment = m_experiments[m_currentExperimentName];
+    currentExperiment["early_stop"] = m_earlyStop;
+}
+
+void DataManager::updateStopReason()
+{
+    auto& currentExperiment = m_experiments[m_currentExperimentName];
+    currentExperiment["stop_reason"] = m_stopReason.toStdString();
+}
+
 void DataManager::updateCycleThreshold()
 {
     auto& currentExperiment = m_experiments[m_currentExperimentName];
     currentExperiment["cycle_threshold"] = m_cycleThreshold;
+    currentExperiment["curve_fit"] = CurveFitter::toNode(m_curveFit);
 }
 
 void DataManager::updateConcentrationCoefficient()
@@ -452,6 +924,27 @@ void DataManager::updateConcentrationMultiplier()
     currentExperiment["concentration_multiplier"] = m_concentrationMultiplier;
 }
 
+void DataManager::updateSampleType()
+{
+    auto& currentExperiment = m_experiments[m_currentExperimentName];
+    currentExperiment["sample_type"] = m_sampleType.toStdString();
+}
+
+void DataManager::updateReplicateGroup()
+{
+    auto& currentExperiment = m_experiments[m_currentExperimentName];
+    currentExperiment["replicate_group"] = m_replicateGroup.toStdString();
+}
+
+void DataManager::updateReplicateStatistics()
+{
+    const double concentration = static_cast<double>(m_concentrationCoefficient.toFloat()) *
+                                 static_cast<double>(m_concentrationMultiplier);
+    setReplicate(m_replicateGroups, m_currentExperimentName, m_replicateGroup, m_sampleType,
+                 concentration, m_cycleThreshold);
+    emit replicateStatisticsChanged();
+}
+
 void DataManager::updateXYStandardCurve()
 {
     auto& currentExperiment = m_experiments[m_currentExperimentName];
@@ -474,15 +967,38 @@ void DataManager::updateCurrentExperimentName(QString& currentExperimentName)
     m_currentExperimentName = currentExperimentName;
 }
 
+void DataManager::ensureExperimentLoaded(const QString& experimentName)
+{
+    if (!m_archive) return;
+
+    if (!m_experiments.contains(experimentName) && m_archive->contains(experimentName)) {
+        fkyaml::node experiment;
+        if (m_archive->restore(experimentName, experiment)) {
+            m_experiments[experimentName] = experiment;
+        }
+    }
+    m_archive->markOpened(experimentName);
+}
+
 void DataManager::loadCurrentExperiment()
 {
+    ensureExperimentLoaded(m_currentExperimentName);
+    if (!m_experiments.contains(m_currentExperimentName)) {
+        // The archive file is missing or corrupt, operator[] would insert a null node and every key read would throw.
+        // The empty template stands in, in memory only, so nothing overwrites what may still be recovered
+        qWarning() << "DataManager: could not restore" << m_currentExperimentName << "- showing an empty experiment";
+        fkyaml::node root = readTemplate(m_currentExperimentName);
+        if (root.is_null()) return;
+        m_experiments[m_currentExperimentName] = root;
+    }
+
     // Assign members with values from experiment node
-    // Emit signal to update the value in the UI
+    // Plain property signals are sent with the next frame, the ones models resize on right away
     auto& root = m_experiments[m_currentExperimentName];
 
     m_lastSaved = root["last_saved"].as_str();
     m_ledIntensity = root["led_intensity_level"].as_int();
-    emit ledIntensityChanged();
+    m_updates.markSignal(this, &DataManager::ledIntensityChanged);
 
     m_maxCycle = root["max_cycle"].as_int();
     setIntensityValuesSize(m_maxCycle);
@@ -500,31 +1016,79 @@ void DataManager::loadCurrentExperiment()
     emit maxCycleChanged();
 
     m_intensityThreshold = root["intensity_threshold"].as_float();
-    emit intensityThresholdChanged();
+    m_updates.markSignal(this, &DataManager::intensityThresholdChanged);
 
-    m_cycleThreshold = root["cycle_threshold"].as_int();
-    emit cycleThresholdChanged();
+    m_autoThreshold = ExperimentAnalysis::settingsOf(root).autoThreshold;
+    m_updates.markSignal(this, &DataManager::autoThresholdChanged);
+
+    // Files saved before the automatic threshold had its own key have no delta yet
+    m_autoThresholdDelta = root.contains("auto_threshold_delta")
+                               ? ExperimentAnalysis::numberValue(root["auto_threshold_delta"]) : 0.0;
+    m_updates.markSignal(this, &DataManager::autoThresholdDeltaChanged);
+
+    // Files saved before melt curves were added have neither key
+    m_meltEnabled = root.contains("melt_enabled") && root["melt_enabled"].get_value_or<bool>(false);
+    m_updates.markSignal(this, &DataManager::meltEnabledChanged);
+
+    m_earlyStop = root.contains("early_stop") && root["early_stop"].get_value_or<bool>(false);
+    m_updates.markSignal(this, &DataManager::earlyStopChanged);
+
+    m_stopReason = root.contains("stop_reason") ? QString::fromStdString(root["stop_reason"].as_str()) : "";
+    m_updates.markSignal(this, &DataManager::stopReasonChanged);
+
+    m_meltAnalyzer.reset();
+    if(root.contains("melt_curve"))
+    {
+        const MeltCurve meltCurve = MeltAnalyzer::fromNode(root["melt_curve"]);
+        for(qsizetype i = 0; i < meltCurve.temperatures.size(); ++i)
+        {
+            m_meltAnalyzer.add(meltCurve.temperatures[i], meltCurve.fluorescence[i]);
+        }
+        m_meltAnalyzer.finish();
+    }
+    m_meltingTemperature = m_meltAnalyzer.curve().meltingTemperature();
+    m_updates.markSignal(this, &DataManager::meltingTemperatureChanged);
+    emit meltCurveUpdated();
+
+    m_cycleThreshold = ExperimentAnalysis::numberValue(root["cycle_threshold"]);
+    m_updates.markSignal(this, &DataManager::cycleThresholdChanged);
+
+    // Files saved before the curve fit was added have no "curve_fit"
+    m_curveFit = root.contains("curve_fit") ? CurveFitter::fromNode(root["curve_fit"]) : CurveFit();
 
     m_concentrationCoefficient = QString::number(root["concentration_coefficient"].as_float());
-    emit concentrationCoefficientChanged();
+    m_updates.markSignal(this, &DataManager::concentrationCoefficientChanged);
 
     m_concentrationMultiplier = root["concentration_multiplier"].as_float();
-    emit concentrationMultiplierChanged();
+    m_updates.markSignal(this, &DataManager::concentrationMultiplierChanged);
+
+    // Files saved before unknowns could be quantified were all standards
+    m_sampleType = root.contains("sample_type") ? QString::fromStdString(root["sample_type"].as_str()) : "standard";
+    m_updates.markSignal(this, &DataManager::sampleTypeChanged);
+
+    // Files saved before replicate groups were added are in none
+    m_replicateGroup = root.contains("replicate_group") && root["replicate_group"].is_string()
+                           ? QString::fromStdString(root["replicate_group"].as_str()) : "";
+    m_updates.markSignal(this, &DataManager::replicateGroupChanged);
+    m_updates.markSignal(this, &DataManager::replicateStatisticsChanged);
 
     m_summary = QString::fromStdString(root["summary"].as_str());
-    emit summaryChanged();
+    m_updates.markSignal(this, &DataManager::summaryChanged);
 
     m_xyLogStandardCurve.clear();
+    m_regression.reset();
     for(auto& point: root["standard_curve_points"].as_seq())
     {
         double x = point[0].as_float();
-        double y = point[1].as_int();
+        double y = ExperimentAnalysis::numberValue(point[1]);
         m_xyLogStandardCurve.append(qMakePair(x, y));
+        m_regression.add(x, y);
+    }
+    // Saved curves are already sorted since points are inserted in order
+    if(!std::is_sorted(m_xyLogStandardCurve.begin(), m_xyLogStandardCurve.end(), byLogConcentration))
+    {
+        std::sort(m_xyLogStandardCurve.begin(), m_xyLogStandardCurve.end(), byLogConcentration);
     }
-    std::sort(m_xyLogStandardCurve.begin(), m_xyLogStandardCurve.end(),
-              [](const QPair<double, int>& a, const QPair<double, int>& b) {
-                  return a.first < b.first;
-              });
     calculateStandardCurve();
     emit xyLogStandardCurveUpdated();
 }
@@ -546,12 +1110,17 @@ void DataManager::removeExperiment(const QString experimentName)
     // Remove from Map and List
     m_experiments.remove(experimentName);
     m_experimentNames.removeAt(idx);
+    m_replicateGroups.remove(experimentName);
 
     // Remove File
     auto resourceFolderName = getenv("RESOURCE_FOLDER_PATH");
     QDir dir = QDir(resourceFolderName).filePath("experiments");
     QString absolutePath = dir.absoluteFilePath(experimentName);
     QFile::remove(absolutePath);
+    if (m_archive) {
+        m_archive->remove(experimentName);
+    }
+    emit experimentRemoved(experimentName);
 
     // Check if we have deleted the last item
     if (m_experimentNames.isEmpty())
@@ -589,10 +1158,13 @@ void DataManager::resetCurrentExperiment()
     // Reset member values
     m_currentIntensityValuesIndex = 0;
     m_cycleThreshold = 0;
+    m_curveFit = CurveFit();
     m_ledIntensity = 0;
     m_maxCycle = 0;
     m_concentrationCoefficient = "1";
     m_concentrationMultiplier = 1.f;
+    m_sampleType = "standard";
+    m_replicateGroup = "";
     m_rSquared =0.0f;
     m_yIntercept = 0.0f;
     m_slope = 0.0f;
@@ -602,37 +1174,56 @@ void DataManager::resetCurrentExperiment()
 
     // update the UI
     emit ledIntensityChanged();
+    emit sampleTypeChanged();
+    emit replicateGroupChanged();
 
     resetIntensityValues();
     resetStandardCurveData();
+    resetMeltCurve();
 
     // assign current experiment node with values from members
     updateCurrentExperiment();
+    updateMeltCurve();
 }
 
-void DataManager::createExperimentFromTemplate(const QString& experimentName)
+fkyaml::node DataManager::readTemplate(const QString& experimentName)
 {
     auto resourceFolderName = getenv("RESOURCE_FOLDER_PATH");
     if (!resourceFolderName) {
         qWarning() << "RESOURCE_FOLDER_PATH not set!";
-        return;
+        return fkyaml::node();
     }
 
     QDir dir = QDir(resourceFolderName).filePath("experiments");
     QString absoluteEmptyPath = dir.absoluteFilePath("templates/empty_experiment.yml");
-    QString absolutePath = dir.absoluteFilePath(experimentName);
 
     std::ifstream templateFile(absoluteEmptyPath.toStdString());
     if (!templateFile.is_open()) {
         qCritical() << "Could not find empty_experiment.yml at" << absoluteEmptyPath;
-        return;
+        return fkyaml::node();
     }
 
     try {
         fkyaml::node root = fkyaml::node::deserialize(templateFile);
         root["experiment_name"] = experimentName.chopped(4).toStdString();
         root["last_saved"] = getCurrTimeStampStr().toStdString();
+        return root;
+    } catch (const fkyaml::exception& e) {
+        qCritical() << "fkYAML Error:" << e.what();
+    }
+    return fkyaml::node();
+}
 
+void DataManager::createExperimentFromTemplate(const QString& experimentName)
+{
+    fkyaml::node root = readTemplate(experimentName);
+    if (root.is_null()) return;
+
+    auto resourceFolderName = getenv("RESOURCE_FOLDER_PATH");
+    QDir dir = QDir(resourceFolderName).filePath("experiments");
+    QString absolutePath = dir.absoluteFilePath(experimentName);
+
+    try {
         m_experiments[experimentName] = root;
         m_experimentNames.push_back(experimentName);
         m_currentExperimentName = experimentName;
@@ -0,0 +1,113 @@
+#include "ExperimentAnalysis.hpp"
+#include "CtEngine.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+AnalysisResult ExperimentAnalysis::analyze(const QList<float>& intensityValues, const AnalysisSettings& settings)
+{
+    AnalysisResult result;
+    result.intensityThreshold = settings.intensityThreshold;
+
+    // An automatic threshold is relative to the baseline, a manual one is raw lux
+    if(settings.autoThreshold)
+    {
+        result.baseline = BaselineEstimator::estimate(intensityValues, static_cast<int>(intensityValues.size()));
+    }
+    if(result.baseline.valid)
+    {
+        result.intensityThreshold = result.baseline.threshold;
+        result.cycleThreshold = CtEngine::findCycleThreshold(
+            BaselineEstimator::subtract(intensityValues, result.baseline), result.intensityThreshold);
+    }
+    else
+    {
+        result.cycleThreshold = CtEngine::findCycleThreshold(intensityValues, result.intensityThreshold);
+    }
+
+    if(settings.fitCurve)
+    {
+        result.curveFit = CurveFitter::fit(intensityValues, settings.model);
+    }
+    return result;
+}
+
+AnalysisSettings ExperimentAnalysis::settingsOf(const fkyaml::node& root)
+{
+    AnalysisSettings settings;
+    settings.intensityThreshold = numberValue(root["intensity_threshold"]);
+    // Older files have no "auto_threshold", their threshold was always manual
+    settings.autoThreshold = root.contains("auto_threshold") && root["auto_threshold"].get_value_or<bool>(false);
+    return settings;
+}
+
+QList<float> ExperimentAnalysis::intensityValuesOf(const fkyaml::node& root)
+{
+    QList<float> intensityValues;
+    if(!root.contains("light_sensor_data") || !root["light_sensor_data"].is_sequence()) return intensityValues;
+
+    const auto& sequence = root["light_sensor_data"].as_seq();
+    intensityValues.reserve(static_cast<qsizetype>(sequence.size()));
+    for(const auto& intensity : sequence)
+    {
+        intensityValues.push_back(static_cast<float>(numberValue(intensity)));
+    }
+    return intensityValues;
+}
+
+void ExperimentAnalysis::store(const AnalysisResult& result, const AnalysisSettings& settings, fkyaml::node& root)
+{
+    // The manual threshold is kept, an automatic one is stored under its own key
+    root["intensity_threshold"] = settings.intensityThreshold;
+    root["auto_threshold"] = settings.autoThreshold;
+    if(result.baseline.valid)
+    {
+        root["auto_threshold_delta"] = result.intensityThreshold;
+    }
+    root["cycle_threshold"] = result.cycleThreshold;
+    if(settings.fitCurve)
+    {
+        root["curve_fit"] = CurveFitter::toNode(result.curveFit);
+    }
+}
+
+double ExperimentAnalysis::numberValue(const fkyaml::node& node)
+{
+    return node.is_integer() ? static_cast<double>(node.as_int()) : node.as_float();
+}
+
+double ExperimentAnalysis::toStoredValue(float value)
+{
+    char buffer[32];
+    const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    double widened = value;
+    if(ec == std::errc())
+    {
+        std::from_chars(buffer, end, widened);
+    }
+    return widened;
+}
+
+double ExperimentAnalysis::calculatePCREfficiency(double slope)
+{
+    // Prevent division by zero
+    // A slope of 0 means Ct never changes regardless of dilution (impossible/bad data).
+    if(std::abs(slope) < 1e-9)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double exponent = -1.0 / slope;
+
+    // std::pow(10, x) will overflow 'double' if x > ~308.
+    // This happens if the slope is extremely small (e.g., -0.000001).
+    if(exponent > 308.0)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    // Calculate Efficiency
+    // Subtract 1 to get the efficiency fraction, multiply by 100 for percentage.
+    return (std::pow(10.0, exponent) - 1.0) * 100.0;
+}
@@ -0,0 +1,317 @@
+#include "ExperimentArchive.hpp"
+#include "ExperimentMetadata.hpp"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+#include <fstream>
+
+namespace {
+constexpr const char* ARCHIVE_FOLDER = "archive";
+constexpr const char* INDEX_FILE = "index.yml";
+// Highest zlib level: archiving is rare, reading back is just as fast
+constexpr int COMPRESSION_LEVEL = 9;
+
+void assignMetadata(ArchiveEntry& entry, const ExperimentMetadata& metadata)
+{
+    entry.experimentName = metadata.experimentName;
+    entry.lastSaved = metadata.lastSaved;
+    entry.rSquared = metadata.rSquared;
+    entry.efficiency = metadata.efficiency;
+    entry.replicateGroup = metadata.replicateGroup;
+    entry.sampleType = metadata.sampleType;
+    entry.cycleThreshold = metadata.cycleThreshold;
+    entry.concentration = metadata.concentration;
+}
+}
+
+ExperimentArchive::ExperimentArchive(const QDir& experimentsDir)
+    : m_experimentsDir{experimentsDir},
+    m_archiveDir{experimentsDir.filePath(ARCHIVE_FOLDER)}
+{
+    loadIndex();
+}
+
+ArchiveReport ExperimentArchive::archiveStale(int days)
+{
+    ArchiveReport report;
+    if(days <= 0) return report;
+
+    if(!m_archiveDir.exists() && !m_experimentsDir.mkpath(ARCHIVE_FOLDER))
+    {
+        qWarning() << "ExperimentArchive: could not create" << m_archiveDir.absolutePath();
+        return report;
+    }
+
+    const QDateTime cutoff = QDateTime::currentDateTime().addDays(-days);
+    const QStringList fileNames = m_experimentsDir.entryList(QStringList() << "*.yml", QDir::Files);
+    for(const auto& fileName : fileNames)
+    {
+        const QFileInfo info(m_experimentsDir.absoluteFilePath(fileName));
+        // Experiments opened before the index existed fall back to their last save
+        const QDateTime lastOpened = m_lastOpened.value(fileName, info.lastModified());
+        if(lastOpened >= cutoff) continue;
+
+        QFile source(info.absoluteFilePath());
+        if(!source.open(QIODevice::ReadOnly)) continue;
+        const QByteArray content = source.readAll();
+        source.close();
+
+        ArchiveEntry entry;
+        try {
+            assignMetadata(entry, ExperimentMetadataReader::read(content));
+        } catch (const fkyaml::exception& e) {
+            qWarning() << "ExperimentArchive: not archiving" << fileName << "-" << e.what();
+            continue;
+        }
+
+        const QByteArray compressed = qCompress(content, COMPRESSION_LEVEL);
+        QFile target(archivePath(fileName));
+        if(!target.open(QIODevice::WriteOnly) || target.write(compressed) != compressed.size())
+        {
+            qWarning() << "ExperimentArchive: failed to write" << target.fileName();
+            target.remove();
+            continue;
+        }
+        target.close();
+        source.remove();
+
+        entry.originalSize = content.size();
+        entry.compressedSize = compressed.size();
+        m_entries[fileName] = entry;
+
+        ++report.experimentsArchived;
+        report.bytesBefore += entry.originalSize;
+        report.bytesAfter += entry.compressedSize;
+    }
+
+    if(report.experimentsArchived > 0)
+    {
+        saveIndex();
+        qInfo() << "ExperimentArchive: archived" << report.experimentsArchived << "experiments,"
+                << report.bytesBefore << "->" << report.bytesAfter << "bytes";
+    }
+    return report;
+}
+
+bool ExperimentArchive::contains(const QString& experimentName) const
+{
+    return m_entries.contains(experimentName);
+}
+
+QStringList ExperimentArchive::archivedNames() const
+{
+    return m_entries.keys();
+}
+
+const QMap<QString, ArchiveEntry>& ExperimentArchive::entries() const
+{
+    return m_entries;
+}
+
+ExperimentMetadata ExperimentArchive::metadata(const QString& experimentName) const
+{
+    const ArchiveEntry entry = m_entries.value(experimentName);
+    ExperimentMetadata metadata;
+    metadata.experimentName = entry.experimentName;
+    metadata.lastSaved = entry.lastSaved;
+    metadata.rSquared = entry.rSquared;
+    metadata.efficiency = entry.efficiency;
+    metadata.replicateGroup = entry.replicateGroup;
+    metadata.sampleType = entry.sampleType;
+    metadata.cycleThreshold = entry.cycleThreshold;
+    metadata.concentration = entry.concentration;
+    return metadata;
+}
+
+bool ExperimentArchive::restore(const QString& experimentName, fkyaml::node& experiment)
+{
+    if(!contains(experimentName)) return false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const QByteArray content = readArchived(experimentName);
+    if(content.isEmpty()) return false;
+
+    try {
+        experiment = fkyaml::node::deserialize(content.toStdString());
+    } catch (const fkyaml::exception& e) {
+        qWarning() << "ExperimentArchive: failed to parse" << experimentName << "-" << e.what();
+        return false;
+    }
+    const qint64 decompressMs = timer.elapsed();
+
+    // Opened again, so it moves back to the active tier
+    QFile target(m_experimentsDir.absoluteFilePath(experimentName));
+    const bool opened = target.open(QIODevice::WriteOnly);
+    if(opened && target.write(content) == content.size())
+    {
+        QFile::remove(archivePath(experimentName));
+        m_entries.remove(experimentName);
+    }
+    else
+    {
+        // It stays archived, a truncated copy would be loaded instead of the archive on the next start
+        qWarning() << "ExperimentArchive: failed to write" << target.fileName();
+        if(opened) target.remove();
+    }
+    markOpened(experimentName);
+    saveIndex();
+
+    qDebug() << "ExperimentArchive: restored" << experimentName << "in" << decompressMs << "ms";
+    return true;
+}
+
+void ExperimentArchive::markOpened(const QString& experimentName)
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    const QDateTime previous = m_lastOpened.value(experimentName);
+    m_lastOpened[experimentName] = now;
+
+    // Staleness is counted in days, so rewriting the index more often only wears the SD card
+    if(!previous.isValid() || previous.daysTo(now) >= 1)
+    {
+        saveIndex();
+    }
+}
+
+void ExperimentArchive::remove(const QString& experimentName)
+{
+    const bool archived = m_entries.remove(experimentName) > 0;
+    const bool tracked = m_lastOpened.remove(experimentName) > 0;
+    if(archived)
+    {
+        QFile::remove(archivePath(experimentName));
+    }
+    if(archived || tracked)
+    {
+        saveIndex();
+    }
+}
+
+void ExperimentArchive::loadIndex()
+{
+    std::ifstream indexFile(m_archiveDir.absoluteFilePath(INDEX_FILE).toStdString());
+    if(!indexFile.is_open()) return;
+
+    QStringList incomplete;
+    try {
+        fkyaml::node root = fkyaml::node::deserialize(indexFile);
+        if(root.contains("last_opened") && root["last_opened"].is_mapping())
+        {
+            for(auto& [name, timestamp] : root["last_opened"].as_map())
+            {
+                m_lastOpened[QString::fromStdString(name.as_str())] =
+                    QDateTime::fromString(QString::fromStdString(timestamp.as_str()), Qt::ISODate);
+            }
+        }
+        if(root.contains("archived") && root["archived"].is_mapping())
+        {
+            for(auto& [name, value] : root["archived"].as_map())
+            {
+                ArchiveEntry entry;
+                entry.experimentName = QString::fromStdString(value["experiment_name"].as_str());
+                entry.lastSaved = QString::fromStdString(value["last_saved"].as_str());
+                entry.rSquared = value["r_squared"].as_float();
+                entry.efficiency = value["efficiency"].as_float();
+                entry.originalSize = value["original_size"].as_int();
+                entry.compressedSize = value["compressed_size"].as_int();
+                const QString fileName = QString::fromStdString(name.as_str());
+                if(value.contains("cycle_threshold"))
+                {
+                    entry.replicateGroup = QString::fromStdString(value["replicate_group"].as_str());
+                    entry.sampleType = QString::fromStdString(value["sample_type"].as_str());
+                    entry.cycleThreshold = value["cycle_threshold"].as_float();
+                    entry.concentration = value["concentration"].as_float();
+                }
+                else
+                {
+                    incomplete.push_back(fileName);
+                }
+                m_entries[fileName] = entry;
+            }
+        }
+    } catch (const fkyaml::exception& e) {
+        qWarning() << "ExperimentArchive: ignoring broken index -" << e.what();
+    }
+    completeIndex(incomplete);
+}
+
+void ExperimentArchive::completeIndex(const QStringList& experimentNames)
+{
+    if(experimentNames.isEmpty()) return;
+
+    // Once per archive: the metadata scan stops at the last wanted key, the samples are never parsed
+    for(const auto& experimentName : experimentNames)
+    {
+        const QByteArray content = readArchived(experimentName);
+        if(content.isEmpty()) continue;
+        try {
+            const ExperimentMetadata metadata = ExperimentMetadataReader::read(content);
+            ArchiveEntry& entry = m_entries[experimentName];
+            entry.replicateGroup = metadata.replicateGroup;
+            entry.sampleType = metadata.sampleType;
+            entry.cycleThreshold = metadata.cycleThreshold;
+            entry.concentration = metadata.concentration;
+        } catch (const fkyaml::exception& e) {
+            qWarning() << "ExperimentArchive: could not read" << experimentName << "-" << e.what();
+        }
+    }
+    saveIndex();
+}
+
+void ExperimentArchive::saveIndex()
+{
+    if(!m_archiveDir.exists() && !m_experimentsDir.mkpath(ARCHIVE_FOLDER)) return;
+
+    fkyaml::node root = fkyaml::node::mapping();
+    root["last_opened"] = fkyaml::node::mapping();
+    root["archived"] = fkyaml::node::mapping();
+
+    for(const auto& [name, timestamp] : m_lastOpened.asKeyValueRange())
+    {
+        root["last_opened"][name.toStdString()] = timestamp.toString(Qt::ISODate).toStdString();
+    }
+    for(const auto& [name, entry] : m_entries.asKeyValueRange())
+    {
+        fkyaml::node value = fkyaml::node::mapping();
+        value["experiment_name"] = entry.experimentName.toStdString();
+        value["last_saved"] = entry.lastSaved.toStdString();
+        value["r_squared"] = entry.rSquared;
+        value["efficiency"] = entry.efficiency;
+        value["replicate_group"] = entry.replicateGroup.toStdString();
+        value["sample_type"] = entry.sampleType.toStdString();
+        value["cycle_threshold"] = entry.cycleThreshold;
+        value["concentration"] = entry.concentration;
+        value["original_size"] = entry.originalSize;
+        value["compressed_size"] = entry.compressedSize;
+        root["archived"][name.toStdString()] = value;
+    }
+
+    std::ofstream indexFile(m_archiveDir.absoluteFilePath(INDEX_FILE).toStdString());
+    indexFile << root;
+}
+
+QString ExperimentArchive::archivePath(const QString& experimentName) const
+{
+    return m_archiveDir.absoluteFilePath(experimentName.chopped(4) + ".z");
+}
+
+QByteArray ExperimentArchive::readArchived(const QString& experimentName) const
+{
+    QFile source(archivePath(experimentName));
+    if(!source.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "ExperimentArchive: missing archive file" << source.fileName();
+        return QByteArray();
+    }
+    const QByteArray content = qUncompress(source.readAll());
+    if(content.isEmpty())
+    {
+        qWarning() << "ExperimentArchive: corrupted archive file" << source.fileName();
+    }
+    return content;
+}
\ No newline at end of file
@@ -0,0 +1,517 @@
+#include "ExperimentImporter.hpp"
+#include "CtEngine.hpp"
+#include "DataManager.hpp"
+#include "ExperimentAnalysis.hpp"
+#include "ExperimentArchive.hpp"
+#include "RegressionAccumulator.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QXmlStreamReader>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+// Reactions kept in memory (and written concurrently) at any time
+constexpr int DEFAULT_BATCH_SIZE = 64;
+// Same upper bound as the Max Cycle input in Setup
+constexpr int MAX_CYCLES = 999;
+}
+
+QString ImportReport::toString() const
+{
+    QString text;
+    QTextStream out(&text);
+    out << "Reactions read: " << reactionsRead << "\n"
+        << "Experiments written: " << experimentsWritten << "\n"
+        << "Standard curve points: " << standardCurvePoints << "\n"
+        << "Slope: " << slope << ", Y-intercept: " << yIntercept
+        << ", R²: " << rSquared << ", Efficiency: " << percentEfficiency << "%\n";
+    for(const auto& warning : warnings)
+    {
+        out << "WARNING: " << warning << "\n";
+    }
+    return text;
+}
+
+ExperimentImporter::ExperimentImporter(const QDir& experimentsDir, const fkyaml::node& templateNode)
+    : m_experimentsDir{experimentsDir},
+    m_template{templateNode},
+    m_intensityThreshold{templateNode["intensity_threshold"].as_float()},
+    m_batchSize{DEFAULT_BATCH_SIZE}
+{
+}
+
+void ExperimentImporter::setBatchSize(int batchSize)
+{
+    m_batchSize = std::max(1, batchSize);
+}
+
+ImportReport ExperimentImporter::importFile(const QString& path)
+{
+    ImportReport report;
+    m_xyLogStandardCurve.clear();
+
+    // An imported run neither overwrites an experiment nor shadows an archived one, which restoring it would overwrite
+    m_existingNames.clear();
+    for(const auto& fileName : m_experimentsDir.entryList(QStringList() << "*.yml", QDir::Files))
+    {
+        m_existingNames.insert(fileName);
+    }
+    for(const auto& fileName : ExperimentArchive(m_experimentsDir).archivedNames())
+    {
+        m_existingNames.insert(fileName);
+    }
+    m_importedNames.clear();
+
+    // Pass 1: only Ct and quantity of the standards are kept. Standards are buffered
+    // m_batchSize at a time so the Ct of a whole batch is found in one engine pass
+    RegressionAccumulator regression;
+    QList<ImportedRun> standards;
+    std::vector<double> cycleThresholds;
+    auto addStandards = [&]() {
+        if(standards.isEmpty()) return;
+
+        int cycleCount = 0;
+        for(const auto& run : standards)
+        {
+            cycleCount = std::max<int>(cycleCount, run.intensityValues.size());
+        }
+        CtEngine engine(static_cast<int>(standards.size()), cycleCount);
+        for(qsizetype i = 0; i < standards.size(); ++i)
+        {
+            engine.setCurve(i, standards[i].intensityValues);
+        }
+        engine.computeCt(m_intensityThreshold, CtEngine::Interpolation::Linear, cycleThresholds);
+
+        for(qsizetype i = 0; i < standards.size(); ++i)
+        {
+            if(cycleThresholds[i] < 0.0) continue;
+
+            const double logQuantity = std::log10(standards[i].quantity);
+            m_xyLogStandardCurve.push_back(qMakePair(logQuantity, cycleThresholds[i]));
+            regression.add(logQuantity, cycleThresholds[i]);
+        }
+        standards.clear();
+    };
+    const bool firstPassOk = streamRuns(path, [&](ImportedRun&& run) {
+        ++report.reactionsRead;
+        if(!validateRun(run, report) || run.quantity <= 0.0) return;
+
+        standards.push_back(std::move(run));
+        if(standards.size() >= m_batchSize) addStandards();
+    }, report);
+    if(!firstPassOk) return report;
+    addStandards();
+
+    std::sort(m_xyLogStandardCurve.begin(), m_xyLogStandardCurve.end(),
+              [](const QPair<double, double>& a, const QPair<double, double>& b) {
+                  return a.first < b.first;
+              });
+    report.standardCurvePoints = m_xyLogStandardCurve.size();
+    if(report.standardCurvePoints >= 5)
+    {
+        auto [slope, intercept, r_squared] = regression.fit();
+        report.slope = slope;
+        report.yIntercept = intercept;
+        report.rSquared = r_squared;
+        report.percentEfficiency = ExperimentAnalysis::calculatePCREfficiency(slope);
+    }
+    m_summary = DataManager::standardCurveSummary(report.standardCurvePoints, report.rSquared);
+
+    // Pass 2: map every reaction onto the experiment schema, batch by batch
+    QList<ImportedRun> batch;
+    batch.reserve(m_batchSize);
+    // Warnings were already collected by the first pass
+    ImportReport secondPassReport;
+    streamRuns(path, [&](ImportedRun&& run) {
+        if(!validateRun(run, secondPassReport)) return;
+
+        batch.push_back(std::move(run));
+        if(batch.size() >= m_batchSize)
+        {
+            flushBatch(batch, report);
+        }
+    }, secondPassReport);
+    flushBatch(batch, report);
+    return report;
+}
+
+bool ExperimentImporter::streamRuns(const QString& path, const RunCallback& onRun, ImportReport& report)
+{
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    if(suffix == "rdml" || suffix == "xml")
+    {
+        return streamRdml(path, onRun, report);
+    }
+    if(suffix == "csv" || suffix == "tsv" || suffix == "txt")
+    {
+        return streamCsv(path, onRun, report);
+    }
+
+    report.warnings << QString("Unsupported import format: %1").arg(path);
+    return false;
+}
+
+bool ExperimentImporter::streamRdml(const QString& path, const RunCallback& onRun, ImportReport& report)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        report.warnings << QString("Could not open %1").arg(path);
+        return false;
+    }
+
+    // Zipped RDML files start with the "PK" local file header
+    if(file.peek(2) == "PK")
+    {
+        report.warnings << QString("%1 is a zipped RDML archive, extract rdml_data.xml first").arg(path);
+        return false;
+    }
+
+    QXmlStreamReader xml(&file);
+
+    // <sample> definitions precede the runs, so only their quantities are kept
+    QHash<QString, double> sampleQuantities;
+    QString currentSampleId;
+    QString runId;
+    QString reactId;
+    QString reactSampleId;
+    ImportedRun run;
+    int cycle = 0;
+    bool inData = false;
+
+    while(!xml.atEnd())
+    {
+        xml.readNext();
+        if(xml.isStartElement())
+        {
+            const auto name = xml.name();
+            if(name == QLatin1String("sample") && !xml.attributes().hasAttribute("id"))
+            {
+                continue;
+            }
+
+            if(name == QLatin1String("sample") && reactId.isEmpty())
+            {
+                currentSampleId = xml.attributes().value("id").toString();
+            }
+            else if(name == QLatin1String("sample"))
+            {
+                reactSampleId = xml.attributes().value("id").toString();
+            }
+            else if(name == QLatin1String("value") && !currentSampleId.isEmpty())
+            {
+                // <sample><quantity><value>
+                sampleQuantities[currentSampleId] = xml.readElementText().toDouble();
+            }
+            else if(name == QLatin1String("run"))
+            {
+                runId = xml.attributes().value("id").toString();
+            }
+            else if(name == QLatin1String("react"))
+            {
+                reactId = xml.attributes().value("id").toString();
+                reactSampleId.clear();
+                currentSampleId.clear();
+            }
+            else if(name == QLatin1String("data") && !reactId.isEmpty())
+            {
+                inData = true;
+                run = ImportedRun{};
+                run.name = runId.isEmpty() ? reactId : runId + "_" + reactId;
+                run.quantity = sampleQuantities.value(reactSampleId, 0.0);
+            }
+            else if(inData && name == QLatin1String("tar"))
+            {
+                run.name += "_" + xml.attributes().value("id").toString();
+            }
+            else if(inData && name == QLatin1String("cyc"))
+            {
+                cycle = std::lround(xml.readElementText().toDouble());
+            }
+            else if(inData && name == QLatin1String("fluor"))
+            {
+                const float fluor = xml.readElementText().toFloat();
+                if(cycle < 1 || cycle > MAX_CYCLES)
+                {
+                    report.warnings << QString("%1: cycle %2 out of range").arg(run.name).arg(cycle);
+                    continue;
+                }
+                if(run.intensityValues.size() < cycle)
+                {
+                    run.intensityValues.resize(cycle);
+                }
+                run.intensityValues[cycle - 1] = fluor;
+            }
+        }
+        else if(xml.isEndElement())
+        {
+            if(xml.name() == QLatin1String("data") && inData)
+            {
+                inData = false;
+                onRun(std::move(run));
+            }
+            else if(xml.name() == QLatin1String("react"))
+            {
+                reactId.clear();
+            }
+            else if(xml.name() == QLatin1String("sample") && reactId.isEmpty())
+            {
+                currentSampleId.clear();
+            }
+        }
+    }
+
+    if(xml.hasError())
+    {
+        report.warnings << QString("%1:%2: %3").arg(path).arg(xml.lineNumber()).arg(xml.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool ExperimentImporter::streamCsv(const QString& path, const RunCallback& onRun, ImportReport& report)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        report.warnings << QString("Could not open %1").arg(path);
+        return false;
+    }
+
+    QTextStream in(&file);
+    const QString header = in.readLine();
+    const QChar separator = header.contains('\t') ? QChar('\t') : header.contains(';') ? QChar(';') : QChar(',');
+    const QStringList columns = header.split(separator);
+
+    int nameColumn = -1;
+    int quantityColumn = -1;
+    // Cycle number per column, 0 for non-cycle columns
+    QList<int> cycleOfColumn(columns.size(), 0);
+    for(int i = 0; i < columns.size(); ++i)
+    {
+        const QString column = columns[i].trimmed().toLower();
+        bool isCycle = false;
+        const int cycle = column.toInt(&isCycle);
+        if(isCycle && cycle >= 1 && cycle <= MAX_CYCLES)
+        {
+            cycleOfColumn[i] = cycle;
+        }
+        else if(column == "name" || column == "well" || column == "sample")
+        {
+            nameColumn = i;
+        }
+        else if(column == "quantity" || column == "concentration")
+        {
+            quantityColumn = i;
+        }
+    }
+
+    if(nameColumn == -1 || std::none_of(cycleOfColumn.begin(), cycleOfColumn.end(), [](int c) { return c > 0; }))
+    {
+        report.warnings << QString("%1: header needs a name column and numbered cycle columns").arg(path);
+        return false;
+    }
+
+    int lineNumber = 1;
+    QString line;
+    while(in.readLineInto(&line))
+    {
+        ++lineNumber;
+        if(line.trimmed().isEmpty()) continue;
+
+        const QStringList fields = line.split(separator);
+        if(fields.size() != columns.size())
+        {
+            report.warnings << QString("%1:%2: expected %3 fields, got %4")
+                                   .arg(path).arg(lineNumber).arg(columns.size()).arg(fields.size());
+            continue;
+        }
+
+        ImportedRun run;
+        run.name = fields[nameColumn].trimmed();
+        if(quantityColumn != -1)
+        {
+            run.quantity = fields[quantityColumn].toDouble();
+        }
+        for(int i = 0; i < fields.size(); ++i)
+        {
+            const int cycle = cycleOfColumn[i];
+            if(cycle == 0) continue;
+
+            if(run.intensityValues.size() < cycle)
+            {
+                run.intensityValues.resize(cycle);
+            }
+            bool ok = false;
+            run.intensityValues[cycle - 1] = fields[i].toFloat(&ok);
+            if(!ok)
+            {
+                run.intensityValues[cycle - 1] = std::numeric_limits<float>::quiet_NaN();
+            }
+        }
+        onRun(std::move(run));
+    }
+    return true;
+}
+
+bool ExperimentImporter::validateRun(const ImportedRun& run, ImportReport& report) const
+{
+    if(run.name.isEmpty())
+    {
+        report.warnings << "Reaction without a name skipped";
+        return false;
+    }
+    if(run.intensityValues.isEmpty())
+    {
+        report.warnings << QString("%1: no amplification data, skipped").arg(run.name);
+        return false;
+    }
+    for(qsizetype i = 0; i < run.intensityValues.size(); ++i)
+    {
+        if(!std::isfinite(run.intensityValues[i]))
+        {
+            report.warnings << QString("%1: invalid value at cycle %2, skipped").arg(run.name).arg(i + 1);
+            return false;
+        }
+    }
+    if(run.quantity < 0.0 || !std::isfinite(run.quantity))
+    {
+        report.warnings << QString("%1: invalid quantity %2, skipped").arg(run.name).arg(run.quantity);
+        return false;
+    }
+    return true;
+}
+
+void ExperimentImporter::flushBatch(QList<ImportedRun>& batch, ImportReport& report)
+{
+    QList<QList<float>> curves;
+    curves.reserve(batch.size());
+    for(const auto& run : std::as_const(batch))
+    {
+        curves.push_back(run.intensityValues);
+    }
+    const QList<CurveFit> curveFits = CurveFitter::fitBatch(curves, m_writerPool);
+
+    // Named here, in reading order, so no two writers of an import ever get the same file
+    QStringList fileNames;
+    fileNames.reserve(batch.size());
+    for(const auto& run : std::as_const(batch))
+    {
+        fileNames.push_back(reserveFileName(run.name, report));
+    }
+
+    for(qsizetype i = 0; i < batch.size(); ++i)
+    {
+        if(fileNames.at(i).isEmpty()) continue;
+
+        m_writerPool.start([this, &batch, &curveFits, &fileNames, i, &report]() {
+            writeExperiment(batch.at(i), curveFits.at(i), fileNames.at(i), report);
+        });
+    }
+    m_writerPool.waitForDone();
+    batch.clear();
+}
+
+QString ExperimentImporter::reserveFileName(const QString& runName, ImportReport& report)
+{
+    const QString requested = experimentFileName(runName);
+    // Runs of one import may share a name, like well "A1" of every run in an RDML file,
+    // or differ only in characters experimentFileName replaces
+    QString fileName = requested;
+    for(int suffix = 2; m_importedNames.contains(fileName); ++suffix)
+    {
+        fileName = QString("%1_%2.yml").arg(requested.chopped(4)).arg(suffix);
+    }
+    m_importedNames.insert(fileName);
+    if(fileName != requested)
+    {
+        report.warnings << QString("%1: %2 already used by this import, written as %3")
+                               .arg(runName, requested, fileName);
+    }
+
+    if(m_existingNames.contains(fileName))
+    {
+        report.warnings << QString("%1 already exists, not overwritten").arg(fileName);
+        return QString();
+    }
+    return fileName;
+}
+
+void ExperimentImporter::writeExperiment(const ImportedRun& run, const CurveFit& curveFit, const QString& fileName,
+                                         ImportReport& report)
+{
+    const double cycleThreshold = CtEngine::findCycleThreshold(run.intensityValues, m_intensityThreshold);
+
+    fkyaml::node root = m_template;
+    root["experiment_name"] = fileName.chopped(4).toStdString();
+    root["max_cycle"] = static_cast<int>(run.intensityValues.size());
+    root["cycle_threshold"] = cycleThreshold;
+    root["curve_fit"] = CurveFitter::toNode(curveFit);
+    root["concentration_coefficient"] = run.quantity > 0.0 ? run.quantity : 1.0;
+    root["concentration_multiplier"] = 1.0;
+    // Wells without a quantity are the unknowns of the plate
+    root["sample_type"] = run.quantity > 0.0 ? "standard" : "unknown";
+    root["r_squared"] = report.rSquared;
+    root["slope"] = report.slope;
+    root["y_intercept"] = report.yIntercept;
+    root["efficiency"] = report.percentEfficiency;
+    root["summary"] = m_summary.toStdString();
+
+    auto& sequence = root["light_sensor_data"].as_seq();
+    sequence.clear();
+    sequence.reserve(run.intensityValues.size());
+    for(float intensity : run.intensityValues)
+    {
+        sequence.push_back(ExperimentAnalysis::toStoredValue(intensity));
+    }
+
+    auto& curvePoints = root["standard_curve_points"].as_seq();
+    curvePoints.clear();
+    for(const auto& point : m_xyLogStandardCurve)
+    {
+        curvePoints.push_back(point);
+    }
+
+    // NewOnly checks and creates in one step, a file made since the import started is never overwritten
+    QFile file(m_experimentsDir.absoluteFilePath(fileName));
+    if(!file.open(QIODevice::WriteOnly | QIODevice::NewOnly))
+    {
+        QMutexLocker locker(&m_reportMutex);
+        report.warnings << (file.exists() ? QString("%1 already exists, not overwritten").arg(fileName)
+                                          : QString("Failed to write %1").arg(fileName));
+        return;
+    }
+    const std::string content = fkyaml::node::serialize(root);
+    const bool written = file.write(content.data(), static_cast<qint64>(content.size()))
+                         == static_cast<qint64>(content.size());
+    if(!written)
+    {
+        file.remove();
+    }
+
+    QMutexLocker locker(&m_reportMutex);
+    if(!written)
+    {
+        report.warnings << QString("Failed to write %1").arg(fileName);
+        return;
+    }
+    ++report.experimentsWritten;
+    report.writtenFiles << fileName;
+}
+
+QString ExperimentImporter::experimentFileName(const QString& runName)
+{
+    static const QRegularExpression invalidCharacters("[^A-Za-z0-9_.-]");
+    QString fileName = runName;
+    fileName.replace(invalidCharacters, "_");
+    return fileName + ".yml";
+}
@@ -0,0 +1,133 @@
+#include "ExperimentMetadata.hpp"
+#include "ExperimentAnalysis.hpp"
+
+#include <string_view>
+
+namespace {
+const QStringList METADATA_KEYS = {
+    "experiment_name", "last_saved", "r_squared", "efficiency", "replicate_group", "sample_type",
+    "cycle_threshold", "concentration_coefficient", "concentration_multiplier"
+};
+
+QMap<QString, fkyaml::node> scalarValues(const fkyaml::node& root, const QStringList& keys)
+{
+    QMap<QString, fkyaml::node> values;
+    if(!root.is_mapping()) return values;
+    for(const auto& key : keys)
+    {
+        const std::string name = key.toStdString();
+        if(root.contains(name) && root[name].is_scalar())
+        {
+            values[key] = root[name];
+        }
+    }
+    return values;
+}
+
+ExperimentMetadata fromValues(const QMap<QString, fkyaml::node>& values)
+{
+    // A missing key is a null node, as_*() throws for it just like on a deserialized file
+    ExperimentMetadata metadata;
+    metadata.experimentName = QString::fromStdString(values.value("experiment_name").as_str());
+    metadata.lastSaved = QString::fromStdString(values.value("last_saved").as_str());
+    metadata.rSquared = ExperimentAnalysis::numberValue(values.value("r_squared"));
+    metadata.efficiency = ExperimentAnalysis::numberValue(values.value("efficiency"));
+
+    // Files saved before replicates and unknowns were added have neither key
+    const fkyaml::node replicateGroup = values.value("replicate_group");
+    if(replicateGroup.is_string())
+    {
+        metadata.replicateGroup = QString::fromStdString(replicateGroup.as_str());
+    }
+    const fkyaml::node sampleType = values.value("sample_type");
+    if(sampleType.is_string())
+    {
+        metadata.sampleType = QString::fromStdString(sampleType.as_str());
+    }
+    if(values.contains("cycle_threshold"))
+    {
+        metadata.cycleThreshold = ExperimentAnalysis::numberValue(values.value("cycle_threshold"));
+    }
+    if(values.contains("concentration_coefficient") && values.contains("concentration_multiplier"))
+    {
+        metadata.concentration = ExperimentAnalysis::numberValue(values.value("concentration_coefficient")) *
+                                 ExperimentAnalysis::numberValue(values.value("concentration_multiplier"));
+    }
+    return metadata;
+}
+}
+
+QMap<QString, fkyaml::node> ExperimentMetadataReader::readKeys(const QByteArray& content, const QStringList& keys)
+{
+    QMap<QString, fkyaml::node> values;
+    try {
+        fkyaml::event_reader reader(content.constBegin(), content.constEnd());
+        if(reader.next() != fkyaml::event_type::MAPPING_BEGIN) return values;
+
+        while(values.size() < keys.size() && reader.next() == fkyaml::event_type::KEY)
+        {
+            const auto rawKey = reader.raw();
+            const QString key = QString::fromUtf8(rawKey.data(), static_cast<qsizetype>(rawKey.size()));
+            if(!keys.contains(key))
+            {
+                reader.skip();
+                continue;
+            }
+
+            // Metadata are scalars, a nested value under a wanted key is left out
+            if(reader.next() == fkyaml::event_type::SCALAR)
+            {
+                values[key] = reader.value();
+            }
+            else
+            {
+                reader.skip();
+            }
+        }
+    } catch (const fkyaml::parse_error&) {
+        // Hand edited files may use anchors or tags, only the full parser understands those
+        fkyaml::node root = fkyaml::node::deserialize(content.toStdString());
+        values = scalarValues(root, keys);
+    }
+    return values;
+}
+
+ExperimentMetadata ExperimentMetadataReader::read(const QByteArray& content)
+{
+    return fromValues(readKeys(content, METADATA_KEYS));
+}
+
+QList<float> ExperimentMetadataReader::readIntensityValues(const QByteArray& content)
+{
+    QList<float> intensityValues;
+    try {
+        fkyaml::event_reader reader(content.constBegin(), content.constEnd());
+        if(reader.next() != fkyaml::event_type::MAPPING_BEGIN) return intensityValues;
+
+        while(reader.next() == fkyaml::event_type::KEY)
+        {
+            const auto rawKey = reader.raw();
+            if(std::string_view(rawKey.data(), rawKey.size()) != "light_sensor_data")
+            {
+                reader.skip();
+                continue;
+            }
+
+            if(reader.next() != fkyaml::event_type::SEQUENCE_BEGIN) return intensityValues;
+            while(reader.next() == fkyaml::event_type::SCALAR)
+            {
+                intensityValues.push_back(static_cast<float>(ExperimentAnalysis::numberValue(reader.value())));
+            }
+            return intensityValues;
+        }
+    } catch (const fkyaml::parse_error&) {
+        fkyaml::node root = fkyaml::node::deserialize(content.toStdString());
+        intensityValues = ExperimentAnalysis::intensityValuesOf(root);
+    }
+    return intensityValues;
+}
+
+ExperimentMetadata ExperimentMetadataReader::fromNode(const fkyaml::node& root)
+{
+    return fromValues(scalarValues(root, METADATA_KEYS));
+}
@@ -1,8 +1,12 @@
 #include "ExperimentModel.hpp"
 
+#include <QDebug>
+
 ExperimentModel::ExperimentModel(QList<QString> &sourceList, QSharedPointer<DataManager> dataManager, QObject *parent)
     : QAbstractListModel(parent), m_dataManager(dataManager), m_dataSource(&sourceList)
 {
+    m_nameIndex = QSet<QString>(sourceList.begin(), sourceList.end());
+    connect(m_dataManager.data(), &DataManager::experimentSaved, this, &ExperimentModel::onExperimentSaved);
 }
 
 int ExperimentModel::rowCount(const QModelIndex &parent) const
@@ -35,6 +39,22 @@ QVariant ExperimentModel::data(const QModelIndex &index, int role) const
         return m_dataSource->at(index.row()); // Return full name
     }
 
+    if (role == SelectedRole) {
+        return m_selectedNames.contains(m_dataSource->at(index.row()));
+    }
+
+    if (role == LastSavedRole) {
+        return metadataAt(index.row()).lastSaved;
+    }
+
+    if (role == RSquaredRole) {
+        return metadataAt(index.row()).rSquared;
+    }
+
+    if (role == EfficiencyRole) {
+        return metadataAt(index.row()).efficiency;
+    }
+
     return QVariant();
 }
 
@@ -44,6 +64,10 @@ QHash<int, QByteArray> ExperimentModel::roleNames() const
     QHash<int, QByteArray> roles;
     roles[Qt::DisplayRole] = "experimentName";
     roles[RealFileNameRole] = "realFileName";
+    roles[SelectedRole] = "selected";
+    roles[LastSavedRole] = "lastSaved";
+    roles[RSquaredRole] = "rSquared";
+    roles[EfficiencyRole] = "efficiency";
     return roles;
 }
 
@@ -51,25 +75,31 @@ void ExperimentModel::refresh()
 {
     // This tells the view that the entire list structure has changed
     beginResetModel();
+    m_nameIndex = QSet<QString>(m_dataSource->begin(), m_dataSource->end());
+    m_metadataCache.clear();
     endResetModel();
 }
 
 void ExperimentModel::addEntry(const QString &name)
 {
     if (name.isEmpty() || !m_dataSource) return;
-    if (m_dataSource->contains(name)) return;
+    if (m_nameIndex.contains(name)) return;
 
     int newRowIndex = m_dataSource->size();
     beginInsertRows(QModelIndex(), newRowIndex, newRowIndex);
     m_dataManager->addExperiment(name);
     m_dataManager->updateCurrentExperiment();
     m_dataSource = &m_dataManager->getExperimentNames();
+    m_nameIndex.insert(name);
     endInsertRows();
 }
 
 void ExperimentModel::removeEntry(int index) {
     QString nameToRemove = m_dataSource->at(index);
     int oldSize = m_dataSource->size();
+    m_selectedNames.remove(nameToRemove);
+    m_nameIndex.remove(nameToRemove);
+    m_metadataCache.remove(nameToRemove);
 
     // Notify View of Removal
     beginRemoveRows(QModelIndex(), index, index);
@@ -88,6 +118,7 @@ void ExperimentModel::removeEntry(int index) {
         // We act as if a new row was inserted at index 0
         beginInsertRows(QModelIndex(), 0, 0);
         // No data change needed, DataManager already has it
+        m_nameIndex.insert(m_dataSource->at(0));
         endInsertRows();
 
         // Force load the new auto-created experiment
@@ -108,3 +139,72 @@ void ExperimentModel::loadExperiment(int index)
     m_dataManager->updateCurrentExperimentName(experimentName);
     m_dataManager->loadCurrentExperiment();
 }
+
+void ExperimentModel::setSelected(int index, bool selected)
+{
+    if (index < 0 || index >= m_dataSource->size()) return;
+
+    const QString& experimentName = m_dataSource->at(index);
+    if (selected == m_selectedNames.contains(experimentName)) return;
+
+    if (selected) {
+        m_selectedNames.insert(experimentName);
+    } else {
+        m_selectedNames.remove(experimentName);
+    }
+    const QModelIndex modelIndex = createIndex(index, 0);
+    emit dataChanged(modelIndex, modelIndex, {SelectedRole});
+}
+
+int ExperimentModel::selectedCount() const
+{
+    return m_selectedNames.size();
+}
+
+void ExperimentModel::buildStandardCurve()
+{
+    // In list order, so the same selection always gives the same curve
+    QStringList experimentNames;
+    for (const auto& experimentName : *m_dataSource) {
+        if (m_selectedNames.contains(experimentName)) {
+            experimentNames.push_back(experimentName);
+        }
+    }
+    m_dataManager->buildStandardCurve(experimentNames);
+}
+
+QString ExperimentModel::nameAt(int row) const
+{
+    if (row < 0 || row >= m_dataSource->size()) return QString();
+    return m_dataSource->at(row);
+}
+
+ExperimentMetadata ExperimentModel::metadataAt(int row) const
+{
+    if (row < 0 || row >= m_dataSource->size()) return ExperimentMetadata();
+
+    const QString& experimentName = m_dataSource->at(row);
+    auto metadata = m_metadataCache.find(experimentName);
+    if (metadata == m_metadataCache.end()) {
+        // A broken file is listed without its metadata rather than failing the whole view
+        ExperimentMetadata read;
+        try {
+            read = m_dataManager->metadataOf(experimentName);
+        } catch (const fkyaml::exception& e) {
+            qWarning() << "ExperimentModel: no metadata for" << experimentName << "-" << e.what();
+        }
+        metadata = m_metadataCache.insert(experimentName, read);
+    }
+    return *metadata;
+}
+
+void ExperimentModel::onExperimentSaved(const QString &experimentName)
+{
+    if (!m_metadataCache.remove(experimentName)) return;
+
+    // Only a row somebody has already read needs to be told
+    const int row = static_cast<int>(m_dataSource->indexOf(experimentName));
+    if (row < 0) return;
+    const QModelIndex modelIndex = createIndex(row, 0);
+    emit dataChanged(modelIndex, modelIndex, {LastSavedRole, RSquaredRole, EfficiencyRole});
+}
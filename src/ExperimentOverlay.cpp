@@ -0,0 +1,128 @@
+#include "ExperimentOverlay.hpp"
+
+#include <QFile>
+
+namespace {
+// The live curve is blue
+const QList<QColor> PALETTE = {
+    QColor("darkorange"), QColor("forestgreen"), QColor("purple"), QColor("crimson"),
+    QColor("teal"), QColor("saddlebrown"), QColor("magenta"), QColor("dimgray")
+};
+}
+
+ExperimentOverlay::ExperimentOverlay(QSharedPointer<DataManager> dataManager, QSharedPointer<ExperimentArchive> archive,
+                                     const QDir& experimentsDir, QObject* parent)
+    : QObject(parent),
+      m_dataManager{dataManager},
+      // Saved file first, an experiment is only in the archive while it is not in the active folder
+      m_cache{[archive, experimentsDir](const QString& experimentName) {
+          QFile file(experimentsDir.absoluteFilePath(experimentName));
+          if(file.open(QIODevice::ReadOnly))
+          {
+              return file.readAll();
+          }
+          return archive ? archive->readArchived(experimentName) : QByteArray();
+      }}
+{
+    connect(&m_cache, &SampleCache::loaded, this, &ExperimentOverlay::onSamplesLoaded);
+    connect(m_dataManager.data(), &DataManager::experimentSaved, this, &ExperimentOverlay::onExperimentSaved);
+    connect(m_dataManager.data(), &DataManager::experimentRemoved, this, &ExperimentOverlay::onExperimentRemoved);
+}
+
+QStringList ExperimentOverlay::pinnedNames() const
+{
+    return m_pinnedNames;
+}
+
+int ExperimentOverlay::pinnedCount() const
+{
+    return static_cast<int>(m_pinnedNames.size());
+}
+
+void ExperimentOverlay::pin(const QString& experimentName)
+{
+    if(experimentName.isEmpty() || m_pinnedNames.contains(experimentName) || m_pinnedNames.size() >= MAX_PINNED) return;
+
+    m_pinnedNames.push_back(experimentName);
+    emit pinnedChanged();
+    if(m_cache.find(experimentName))
+    {
+        emit curvesChanged();
+    }
+    else
+    {
+        m_cache.request(experimentName);
+    }
+}
+
+void ExperimentOverlay::pinCurrent()
+{
+    pin(m_dataManager->m_currentExperimentName);
+}
+
+void ExperimentOverlay::unpin(const QString& experimentName)
+{
+    if(!m_pinnedNames.removeOne(experimentName)) return;
+
+    // Stays in the cache, pinning it again is immediate
+    emit pinnedChanged();
+    emit curvesChanged();
+}
+
+void ExperimentOverlay::clear()
+{
+    if(m_pinnedNames.isEmpty()) return;
+
+    m_pinnedNames.clear();
+    emit pinnedChanged();
+    emit curvesChanged();
+}
+
+bool ExperimentOverlay::isPinned(const QString& experimentName) const
+{
+    return m_pinnedNames.contains(experimentName);
+}
+
+QColor ExperimentOverlay::colorAt(int index) const
+{
+    return PALETTE.at(index % PALETTE.size());
+}
+
+QList<PlotCurve> ExperimentOverlay::curves()
+{
+    QList<PlotCurve> curves;
+    curves.reserve(m_pinnedNames.size());
+    for(int i = 0; i < m_pinnedNames.size(); ++i)
+    {
+        const SampleCache::Samples samples = m_cache.find(m_pinnedNames[i]);
+        if(samples)
+        {
+            curves.push_back(PlotCurve{samples, colorAt(i)});
+        }
+    }
+    return curves;
+}
+
+void ExperimentOverlay::onSamplesLoaded(const QString& experimentName)
+{
+    if(m_pinnedNames.contains(experimentName))
+    {
+        emit curvesChanged();
+    }
+}
+
+void ExperimentOverlay::onExperimentSaved(const QString& experimentName)
+{
+    m_cache.invalidate(experimentName);
+    if(m_pinnedNames.contains(experimentName))
+    {
+        // The old readings stay drawn until the new ones are read
+        m_cache.request(experimentName);
+    }
+}
+
+void ExperimentOverlay::onExperimentRemoved(const QString& experimentName)
+{
+    m_cache.invalidate(experimentName);
+    unpin(experimentName);
+}
@@ -0,0 +1,182 @@
+#include "ExperimentProxyModel.hpp"
+
+ExperimentProxyModel::ExperimentProxyModel(ExperimentModel *experimentModel, QObject *parent)
+    : QSortFilterProxyModel(parent), m_experimentModel(experimentModel)
+{
+    // Connected before setSourceModel(), so keys are in place when the proxy sorts and filters new rows
+    connect(m_experimentModel, &QAbstractItemModel::rowsInserted, this, &ExperimentProxyModel::onRowsInserted);
+    connect(m_experimentModel, &QAbstractItemModel::rowsRemoved, this, &ExperimentProxyModel::onRowsRemoved);
+    connect(m_experimentModel, &QAbstractItemModel::modelReset, this, &ExperimentProxyModel::rebuildKeys);
+    connect(m_experimentModel, &QAbstractItemModel::dataChanged, this, &ExperimentProxyModel::onDataChanged);
+
+    rebuildKeys();
+    setSourceModel(m_experimentModel);
+    sort(0, Qt::AscendingOrder);
+}
+
+QString ExperimentProxyModel::filterText() const
+{
+    return m_filterText;
+}
+
+void ExperimentProxyModel::setFilterText(const QString &filterText)
+{
+    if (filterText == m_filterText) return;
+
+    const QString needle = filterText.toLower();
+    // Typing on narrows the matches, rows that did not match before cannot match now
+    const bool narrowing = needle.contains(m_needle);
+    m_filterText = filterText;
+    m_needle = needle;
+    for (qsizetype row = 0; row < m_keys.size(); ++row) {
+        if (narrowing && !m_accepted[row]) continue;
+        m_accepted[row] = matches(m_keys[row]);
+    }
+    invalidateRowsFilter();
+    emit filterTextChanged();
+}
+
+ExperimentProxyModel::SortKey ExperimentProxyModel::sortKey() const
+{
+    return m_sortKey;
+}
+
+void ExperimentProxyModel::setSortKey(SortKey sortKey)
+{
+    if (sortKey == m_sortKey) return;
+
+    m_sortKey = sortKey;
+    updateSortKeys(0, static_cast<int>(m_keys.size()) - 1);
+    invalidate();
+    emit sortKeyChanged();
+}
+
+bool ExperimentProxyModel::descending() const
+{
+    return m_descending;
+}
+
+void ExperimentProxyModel::setDescending(bool descending)
+{
+    if (descending == m_descending) return;
+
+    m_descending = descending;
+    sort(0, m_descending ? Qt::DescendingOrder : Qt::AscendingOrder);
+    emit descendingChanged();
+}
+
+int ExperimentProxyModel::sourceRow(int proxyRow) const
+{
+    const QModelIndex sourceIndex = mapToSource(index(proxyRow, 0));
+    return sourceIndex.isValid() ? sourceIndex.row() : -1;
+}
+
+int ExperimentProxyModel::proxyRow(int sourceRow) const
+{
+    const QModelIndex proxyIndex = mapFromSource(m_experimentModel->index(sourceRow, 0));
+    return proxyIndex.isValid() ? proxyIndex.row() : -1;
+}
+
+bool ExperimentProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &) const
+{
+    return sourceRow >= 0 && sourceRow < static_cast<int>(m_accepted.size()) && m_accepted[sourceRow];
+}
+
+bool ExperimentProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+    const Key &a = m_keys[left.row()];
+    const Key &b = m_keys[right.row()];
+    switch (m_sortKey) {
+    case LastSaved:
+        if (a.text != b.text) return a.text < b.text;
+        break;
+    case RSquared:
+    case Efficiency:
+        if (a.number != b.number) return a.number < b.number;
+        break;
+    case Name:
+        break;
+    }
+    // By name within equal keys, so the order never depends on the order rows came in
+    return a.name < b.name;
+}
+
+ExperimentProxyModel::Key ExperimentProxyModel::makeKey(int sourceRow) const
+{
+    Key key;
+    QString name = m_experimentModel->nameAt(sourceRow);
+    if (name.endsWith(".yml")) {
+        name.chop(4);
+    }
+    key.name = name.toLower();
+
+    switch (m_sortKey) {
+    case LastSaved:
+        // "YYYY-MM-DD HH:MM:SS", sorts as text
+        key.text = m_experimentModel->metadataAt(sourceRow).lastSaved;
+        break;
+    case RSquared:
+        key.number = m_experimentModel->metadataAt(sourceRow).rSquared;
+        break;
+    case Efficiency:
+        key.number = m_experimentModel->metadataAt(sourceRow).efficiency;
+        break;
+    case Name:
+        break;
+    }
+    return key;
+}
+
+bool ExperimentProxyModel::matches(const Key &key) const
+{
+    return m_needle.isEmpty() || key.name.contains(m_needle);
+}
+
+void ExperimentProxyModel::rebuildKeys()
+{
+    const int count = m_experimentModel->rowCount();
+    m_keys.clear();
+    m_keys.reserve(count);
+    m_accepted.assign(count, 0);
+    for (int row = 0; row < count; ++row) {
+        m_keys.push_back(makeKey(row));
+        m_accepted[row] = matches(m_keys.back());
+    }
+}
+
+void ExperimentProxyModel::updateSortKeys(int first, int last)
+{
+    for (int row = first; row <= last; ++row) {
+        const Key key = makeKey(row);
+        m_keys[row].text = key.text;
+        m_keys[row].number = key.number;
+    }
+}
+
+void ExperimentProxyModel::onRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+
+    for (int row = first; row <= last; ++row) {
+        const Key key = makeKey(row);
+        m_keys.insert(row, key);
+        m_accepted.insert(m_accepted.begin() + row, matches(key));
+    }
+}
+
+void ExperimentProxyModel::onRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+
+    m_keys.remove(first, last - first + 1);
+    m_accepted.erase(m_accepted.begin() + first, m_accepted.begin() + last + 1);
+}
+
+void ExperimentProxyModel::onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                                         const QList<int> &roles)
+{
+    // Selection does not change any key
+    if (roles.size() == 1 && roles.front() == ExperimentModel::SelectedRole) return;
+
+    updateSortKeys(topLeft.row(), bottomRight.row());
+}
@@ -1,5 +1,6 @@
 #include <QDebug>
 #include <QThread>
+#include <QRandomGenerator>
 
 #include <cmath>
 
@@ -50,6 +51,10 @@ HardwareController::HardwareController(uint8_t sensorAddr, int adapter, int ledP
      */
     m_sensorTimer->setInterval(2000); 
     connect(m_sensorTimer, &QTimer::timeout, this, &HardwareController::onSensorTimer);
+
+    m_meltTimer = new QTimer(this);
+    m_meltTimer->setInterval(MELT_SAMPLE_INTERVAL_MS);
+    connect(m_meltTimer, &QTimer::timeout, this, &HardwareController::onMeltTimer);
     begin();
 }
 
@@ -216,7 +221,62 @@ void HardwareController::onSensorTimer()
             performSensorReading();
             qDebug() << "HardwareController: pcrCycle:" << m_pcrCycle;
     }
-    else stopSensorReading();
+    else finishAmplification();
+}
+
+void HardwareController::finishAmplification()
+{
+    if (!m_sensorTimer->isActive()) {
+        return;
+    }
+    stopSensorReading();
+    emit amplificationFinished();
+}
+
+/**
+ * Public Slot : Starts the post-run melt ramp
+ * The heating block is not driven by gwi, the temperature of every sample is
+ * the ramp setpoint at the time it is read
+ *
+ */
+void HardwareController::startMeltRamp()
+{
+    if (!m_isInitialized) {
+        return;
+    }
+
+#ifdef HAVE_WIRINGPI
+    // -- Continuous low resolution mode converts every 16 ms, fast enough for the ramp
+    if (!writeToSensor(CONTINUOUSLY_L_RES_MODE)) {
+        emit errorOccurred("Failed to write to sensor");
+        return;
+    }
+#endif
+
+    m_meltClock.start();
+    m_meltTimer->start();
+    qDebug() << "HardwareController: Started melt ramp";
+}
+
+void HardwareController::stopMeltRamp()
+{
+    if (!m_meltTimer->isActive()) {
+        return;
+    }
+    m_meltTimer->stop();
+    qDebug() << "HardwareController: Stopped melt ramp";
+}
+
+void HardwareController::onMeltTimer()
+{
+    const float temperature = MELT_START_TEMPERATURE + MELT_RAMP_RATE * m_meltClock.elapsed() / 1000.0f;
+    if (temperature <= MELT_END_TEMPERATURE) {
+        performMeltReading();
+    }
+    else {
+        stopMeltRamp();
+        emit meltRampFinished();
+    }
 }
 
 #ifdef HAVE_WIRINGPI
@@ -267,6 +327,20 @@ float HardwareController::readLuxFromSensor()
     qDebug() << "HardwareController: Light detected:" << lux << "lx";
     return lux;
 }
+
+void HardwareController::performMeltReading()
+{
+    if (!m_isInitialized || m_i2cFd < 0) {
+        return;
+    }
+
+    // -- No wait, continuous mode always holds the latest conversion
+    const float temperature = MELT_START_TEMPERATURE + MELT_RAMP_RATE * m_meltClock.elapsed() / 1000.0f;
+    float lux = readLuxFromSensor();
+    if (lux >= 0) {
+        emit meltSampleReady(temperature, lux);
+    }
+}
 #else
 void HardwareController::performSensorReading()
 {
@@ -283,4 +357,17 @@ void HardwareController::performSensorReading()
         emit sensorDataReady(lux);
     }
 }
+
+void HardwareController::performMeltReading()
+{
+    if (!m_isInitialized || m_i2cFd < 0) {
+        return;
+    }
+
+    // -- Product melting at 84 °C over a slowly falling background, with some sensor noise
+    const float temperature = MELT_START_TEMPERATURE + MELT_RAMP_RATE * m_meltClock.elapsed() / 1000.0f;
+    float lux = 150 / (1 + exp((temperature - 84) / 0.8)) + 40 - 0.3 * (temperature - MELT_START_TEMPERATURE);
+    lux += QRandomGenerator::global()->bounded(1.0) - 0.5;
+    emit meltSampleReady(temperature, lux);
+}
 #endif
@@ -0,0 +1,167 @@
+#include "MeltAnalyzer.hpp"
+#include "ExperimentAnalysis.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+QList<float> floatSequence(const fkyaml::node& node, const char* key)
+{
+    QList<float> values;
+    if(!node.contains(key) || !node[key].is_sequence()) return values;
+
+    const auto& sequence = node[key].as_seq();
+    values.reserve(static_cast<qsizetype>(sequence.size()));
+    for(const auto& value : sequence)
+    {
+        values.push_back(static_cast<float>(ExperimentAnalysis::numberValue(value)));
+    }
+    return values;
+}
+}
+
+double MeltCurve::meltingTemperature() const
+{
+    return peaks.isEmpty() ? 0.0 : peaks.front().temperature;
+}
+
+MeltAnalyzer::MeltAnalyzer(int halfWidth)
+    : m_halfWidth{std::max(1, halfWidth)}
+{
+    const double m = m_halfWidth;
+    const double sumOfSquares = m * (m + 1.0) * (2.0 * m + 1.0) / 3.0;
+    m_taps.reserve(2 * m_halfWidth + 1);
+    for(int k = -m_halfWidth; k <= m_halfWidth; ++k)
+    {
+        m_taps.push_back(k / sumOfSquares);
+    }
+}
+
+void MeltAnalyzer::reset()
+{
+    m_curve = MeltCurve();
+}
+
+bool MeltAnalyzer::add(float temperature, float fluorescence)
+{
+    m_curve.temperatures.push_back(temperature);
+    m_curve.fluorescence.push_back(fluorescence);
+    m_curve.derivative.push_back(std::numeric_limits<float>::quiet_NaN());
+
+    const qsizetype window = static_cast<qsizetype>(m_taps.size());
+    const qsizetype first = m_curve.fluorescence.size() - window;
+    if(first < 0) return false;
+
+    const float* values = m_curve.fluorescence.data() + first;
+    double slope = 0.0;
+    for(qsizetype k = 0; k < window; ++k)
+    {
+        slope += m_taps[k] * values[k];
+    }
+    const double step = (static_cast<double>(temperature) - m_curve.temperatures[first]) / (window - 1);
+    // A ramp that stalled has no temperature scale, leave the derivative undefined
+    if(std::abs(step) < 1e-9) return false;
+
+    m_curve.derivative[first + m_halfWidth] = static_cast<float>(-slope / step);
+    return true;
+}
+
+void MeltAnalyzer::finish()
+{
+    m_curve.peaks = findPeaks(m_curve.temperatures, m_curve.derivative);
+}
+
+const MeltCurve& MeltAnalyzer::curve() const
+{
+    return m_curve;
+}
+
+MeltCurve MeltAnalyzer::analyze(const QList<float>& temperatures, const QList<float>& fluorescence, int halfWidth)
+{
+    MeltAnalyzer analyzer(halfWidth);
+    const qsizetype count = std::min(temperatures.size(), fluorescence.size());
+    analyzer.m_curve.temperatures.reserve(count);
+    analyzer.m_curve.fluorescence.reserve(count);
+    analyzer.m_curve.derivative.reserve(count);
+    for(qsizetype i = 0; i < count; ++i)
+    {
+        analyzer.add(temperatures[i], fluorescence[i]);
+    }
+    analyzer.finish();
+    return analyzer.m_curve;
+}
+
+QList<MeltPeak> MeltAnalyzer::findPeaks(const QList<float>& temperatures, const QList<float>& derivative)
+{
+    const qsizetype n = derivative.size();
+    double highest = 0.0;
+    for(const float value : derivative)
+    {
+        // NaN compares false, the unfiltered ends are skipped
+        if(value > highest) highest = value;
+    }
+
+    QList<MeltPeak> peaks;
+    for(qsizetype i = 1; i + 1 < n; ++i)
+    {
+        const double left = derivative[i - 1];
+        const double center = derivative[i];
+        const double right = derivative[i + 1];
+        if(!(center > left && center >= right && center >= MIN_PEAK_FRACTION * highest)) continue;
+
+        // Lowest point on each side before the derivative rises above this peak again
+        double leftBase = center;
+        for(qsizetype j = i - 1; j >= 0 && derivative[j] <= center; --j)
+        {
+            leftBase = std::min<double>(leftBase, derivative[j]);
+        }
+        double rightBase = center;
+        for(qsizetype j = i + 1; j < n && derivative[j] <= center; ++j)
+        {
+            rightBase = std::min<double>(rightBase, derivative[j]);
+        }
+        if(center - std::max(leftBase, rightBase) < MIN_PEAK_FRACTION * highest) continue;
+
+        const double curvature = left - 2.0 * center + right;
+        const double offset = curvature < 0.0 ? 0.5 * (left - right) / curvature : 0.0;
+        MeltPeak peak;
+        peak.temperature = temperatures[i] + offset * 0.5 * (temperatures[i + 1] - temperatures[i - 1]);
+        peak.height = center - 0.25 * (left - right) * offset;
+        peaks.push_back(peak);
+    }
+
+    std::sort(peaks.begin(), peaks.end(), [](const MeltPeak& a, const MeltPeak& b) { return a.height > b.height; });
+    return peaks;
+}
+
+fkyaml::node MeltAnalyzer::toNode(const MeltCurve& meltCurve)
+{
+    fkyaml::node node = fkyaml::node::mapping();
+    node["melting_temperature"] = meltCurve.meltingTemperature();
+
+    fkyaml::node peaks = fkyaml::node::sequence();
+    for(const auto& peak : meltCurve.peaks)
+    {
+        peaks.as_seq().push_back(fkyaml::node::sequence({peak.temperature, peak.height}));
+    }
+    node["peaks"] = peaks;
+
+    fkyaml::node temperatures = fkyaml::node::sequence();
+    fkyaml::node fluorescence = fkyaml::node::sequence();
+    for(qsizetype i = 0; i < meltCurve.temperatures.size(); ++i)
+    {
+        temperatures.as_seq().push_back(ExperimentAnalysis::toStoredValue(meltCurve.temperatures[i]));
+        fluorescence.as_seq().push_back(ExperimentAnalysis::toStoredValue(meltCurve.fluorescence[i]));
+    }
+    node["temperatures"] = temperatures;
+    node["fluorescence"] = fluorescence;
+    return node;
+}
+
+MeltCurve MeltAnalyzer::fromNode(const fkyaml::node& node)
+{
+    if(!node.is_mapping()) return MeltCurve();
+
+    return analyze(floatSequence(node, "temperatures"), floatSequence(node, "fluorescence"));
+}
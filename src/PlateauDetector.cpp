@@ -0,0 +1,73 @@
+#include "PlateauDetector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+PlateauDetector::PlateauDetector(int wellCount, double tolerance, int consecutiveCycles)
+    : m_tolerance{tolerance},
+    m_consecutiveCycles{std::max(1, consecutiveCycles)},
+    m_wells(static_cast<size_t>(std::max(1, wellCount)))
+{
+}
+
+void PlateauDetector::reset()
+{
+    std::fill(m_wells.begin(), m_wells.end(), WellState());
+    m_cycleCount = 0;
+    m_plateauCycle = 0;
+}
+
+bool PlateauDetector::addCycle(const QList<float>& readings, const QList<double>& thresholds)
+{
+    ++m_cycleCount;
+    bool allDone = true;
+    for(size_t well = 0; well < m_wells.size(); ++well)
+    {
+        WellState& state = m_wells[well];
+        // A well without a reading this cycle keeps its state
+        if(static_cast<qsizetype>(well) >= readings.size() || static_cast<qsizetype>(well) >= thresholds.size())
+        {
+            allDone = allDone && state.flatCycles >= m_consecutiveCycles;
+            continue;
+        }
+
+        const float reading = readings[well];
+        if(state.crossed)
+        {
+            const double relativeSlope = std::abs(reading - state.previous) / std::max(std::abs(reading), 1e-6f);
+            state.flatCycles = relativeSlope < m_tolerance ? state.flatCycles + 1 : 0;
+        }
+        else
+        {
+            state.crossed = reading >= thresholds[well];
+        }
+        state.previous = reading;
+        allDone = allDone && state.flatCycles >= m_consecutiveCycles;
+    }
+
+    if(allDone && m_plateauCycle == 0)
+    {
+        m_plateauCycle = m_cycleCount;
+    }
+    return allDone;
+}
+
+bool PlateauDetector::addReading(float reading, double threshold)
+{
+    return addCycle(QList<float>{reading}, QList<double>{threshold});
+}
+
+int PlateauDetector::cycleCount() const
+{
+    return m_cycleCount;
+}
+
+bool PlateauDetector::plateaued() const
+{
+    return m_plateauCycle > 0;
+}
+
+int PlateauDetector::plateauCycle() const
+{
+    return m_plateauCycle;
+}
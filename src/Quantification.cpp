@@ -0,0 +1,101 @@
+#include "Quantification.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+// t(0.975, ν) for ν = 1..30
+constexpr std::array<double, 30> STUDENT_T_975 = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+}
+
+double Quantity::quantity() const
+{
+    return std::pow(10.0, logQuantity);
+}
+
+double Quantity::lower() const
+{
+    return std::pow(10.0, logQuantity - halfWidth);
+}
+
+double Quantity::upper() const
+{
+    return std::pow(10.0, logQuantity + halfWidth);
+}
+
+CalibrationCurve Quantification::calibrationCurve(const RegressionAccumulator& regression)
+{
+    CalibrationCurve curve;
+    const auto [slope, intercept, rSquared] = regression.fit();
+    // At least one degree of freedom is left for the residual spread
+    if(regression.count() < 3 || std::abs(slope) < 1e-9 || regression.ssXX() < 1e-12) return curve;
+
+    curve.slope = slope;
+    curve.intercept = intercept;
+    curve.pointCount = regression.count();
+    curve.meanX = regression.meanX();
+    curve.meanY = regression.meanY();
+    curve.ssXX = regression.ssXX();
+    curve.residualSd = std::sqrt(std::max(0.0, regression.residualSumOfSquares()) / (curve.pointCount - 2));
+    curve.t = studentT975(curve.pointCount - 2);
+    curve.valid = true;
+    return curve;
+}
+
+Quantity Quantification::quantify(const CalibrationCurve& curve, double cycleThreshold)
+{
+    Quantity quantity;
+    quantifyBatch(curve, &cycleThreshold, 1, &quantity.logQuantity, &quantity.halfWidth);
+    quantity.valid = std::isfinite(quantity.logQuantity);
+    return quantity;
+}
+
+void Quantification::quantifyBatch(const CalibrationCurve& curve, const double* cycleThresholds, std::size_t count,
+                                   double* logQuantity, double* halfWidth)
+{
+    constexpr double noValue = std::numeric_limits<double>::quiet_NaN();
+    if(!curve.valid)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            logQuantity[i] = noValue;
+            halfWidth[i] = noValue;
+        }
+        return;
+    }
+
+    // Everything that only depends on the curve, the loop itself has no branches
+    const double inverseSlope = 1.0 / curve.slope;
+    const double intercept = curve.intercept;
+    const double meanY = curve.meanY;
+    const double scale = curve.t * curve.residualSd / std::abs(curve.slope);
+    const double base = 1.0 + 1.0 / curve.pointCount;
+    const double leverage = 1.0 / (curve.slope * curve.slope * curve.ssXX);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const double cycleThreshold = cycleThresholds[i];
+        const double dy = cycleThreshold - meanY;
+        const double x = (cycleThreshold - intercept) * inverseSlope;
+        // NaN where the threshold was never crossed, added instead of selected to stay branch free
+        const double missing = cycleThreshold >= 0.0 ? 0.0 : noValue;
+        logQuantity[i] = x + missing;
+        halfWidth[i] = scale * std::sqrt(base + dy * dy * leverage) + missing;
+    }
+}
+
+double Quantification::studentT975(int degreesOfFreedom)
+{
+    if(degreesOfFreedom < 1) return std::numeric_limits<double>::infinity();
+    if(degreesOfFreedom <= static_cast<int>(STUDENT_T_975.size())) return STUDENT_T_975[degreesOfFreedom - 1];
+
+    // Cornish–Fisher expansion around the normal quantile, within 1e-4 past ν = 30
+    const double z = 1.959964;
+    const double v = degreesOfFreedom;
+    return z + (z * z * z + z) / (4.0 * v) + (5.0 * std::pow(z, 5) + 16.0 * z * z * z + 3.0 * z) / (96.0 * v * v);
+}
@@ -1,23 +1,44 @@
 #include "RawDataModel.hpp"
 
+#include <algorithm>
+
+namespace {
+const QString CYCLE_HEADER = QStringLiteral("Cycle");
+const QString INTENSITY_HEADER = QStringLiteral("Flourescence Intensity");
+}
+
 RawDataModel::RawDataModel(QSharedPointer<DataManager> dataManager)
     : m_dataManager{dataManager}
 {
+    const QList<float>& values = m_dataManager->getIntensityValuesList();
+    m_rows.reserve(values.size());
+    for(qsizetype i = 0; i < values.size(); ++i)
+    {
+        m_rows.push_back(makeRow(static_cast<int>(i) + 1, values[i]));
+    }
+
     connect(m_dataManager.data(), &DataManager::intensityValuesUpdated,
             this, &RawDataModel::onIntensityValuesUpdated);
 
-    // When experiment changes, reset the whole model
+    // When experiment changes, bring the rows in line
     connect(m_dataManager.data(), &DataManager::currentExperimentNameChanged,
             this, &RawDataModel::refresh);
 
-    // Also reset if the max cycle changes (e.g., user edits Setup)
+    // Also if the max cycle changes (e.g., user edits Setup)
     connect(m_dataManager.data(), &DataManager::maxCycleChanged,
             this, &RawDataModel::refresh);
+
+    // And when a new run clears the readings
+    connect(m_dataManager.data(), &DataManager::intensityValuesReset,
+            this, &RawDataModel::refresh);
+
+    connect(&m_updates, &UpdateCoalescer::rowsChanged,
+            this, &RawDataModel::onRowsChanged);
 }
 
 int RawDataModel::rowCount(const QModelIndex &) const
 {
-    return m_dataManager->getIntensityValuesSize() + 1;
+    return static_cast<int>(m_rows.size()) + 1;
 }
 
 int RawDataModel::columnCount(const QModelIndex &) const
@@ -27,44 +48,30 @@ int RawDataModel::columnCount(const QModelIndex &) const
 
 QVariant RawDataModel::data(const QModelIndex &index, int role) const
 {
+    if(index.row() == 0)
+    {
+        // column name
+        if(role != Qt::DisplayRole) return QVariant();
+        return index.column() == 0 ? CYCLE_HEADER : INTENSITY_HEADER;
+    }
+
+    // handle out of bound access
+    const qsizetype row = index.row() - 1;
+    if(row < 0 || row >= m_rows.size())
+    {
+        return QVariant();
+    }
+
+    const Row& cached = m_rows[row];
     switch (role) {
     case Qt::DisplayRole:
-        if(index.row() == 0)
-        {
-            // column name
-            if(index.column() == 0)
-            {
-                return QString("Cycle");
-            }
-            else
-            {
-                return QString("Flourescence Intensity");
-            }
-        }
-        else
-        {
-            // handle out of bound access
-            if(index.row() > m_dataManager->getIntensityValuesSize())
-            {
-                return QString();
-            }
-
-            // cycle number
-            if(index.column() == 0)
-            {
-                return QString("%1").arg(index.row());
-            }
-
-            // intensity value
-            auto value = m_dataManager->getIntensityValueByIndex(index.row() - 1);
-            return QString("%1").arg(value);
-        }
+        return index.column() == 0 ? cached.cycle : cached.intensity;
 
     case XValueRole:
         return index.row();
 
     case YValueRole:
-        return m_dataManager->getIntensityValueByIndex(index.row() - 1);
+        return cached.value;
 
     default:
         break;
@@ -84,16 +91,75 @@ QHash<int, QByteArray> RawDataModel::roleNames() const
 
 void RawDataModel::onIntensityValuesUpdated(int index, float value)
 {
-    int tableRow = index + 1; // +1 because row 0 is the header
-    
-    QModelIndex startIndex = createIndex(tableRow, 1);
-    QModelIndex endIndex = startIndex;
-    
-    emit dataChanged(startIndex, endIndex, {Qt::DisplayRole});
+    if(index < 0) return;
+    // A reading past the cached rows, the list grew since the last refresh
+    if(index >= m_rows.size())
+    {
+        refresh();
+        return;
+    }
+
+    m_rows[index] = makeRow(index + 1, value);
+    m_updates.markRows(index, index);
+}
+
+void RawDataModel::onRowsChanged(int first, int last)
+{
+    // +1 because row 0 is the header
+    emit dataChanged(createIndex(first + 1, 1), createIndex(last + 1, 1), {Qt::DisplayRole, YValueRole});
 }
 
 void RawDataModel::refresh()
 {
-    beginResetModel();
-    endResetModel();
+    // Pending rows still refer to the rows as they are now
+    m_updates.flush();
+
+    const QList<float>& values = m_dataManager->getIntensityValuesList();
+    const qsizetype oldCount = m_rows.size();
+    const qsizetype newCount = values.size();
+
+    // Table rows are one past the cycle index, row 0 is the header
+    if(newCount < oldCount)
+    {
+        beginRemoveRows(QModelIndex(), static_cast<int>(newCount) + 1, static_cast<int>(oldCount));
+        m_rows.resize(newCount);
+        endRemoveRows();
+    }
+
+    // Rows whose reading changed, reported as one range from the first to the last of them
+    qsizetype firstChanged = -1;
+    qsizetype lastChanged = -1;
+    for(qsizetype i = 0; i < std::min(oldCount, newCount); ++i)
+    {
+        if(m_rows[i].value == values[i]) continue;
+        m_rows[i] = makeRow(static_cast<int>(i) + 1, values[i]);
+        if(firstChanged < 0) firstChanged = i;
+        lastChanged = i;
+    }
+    if(firstChanged >= 0)
+    {
+        emit dataChanged(createIndex(static_cast<int>(firstChanged) + 1, 1),
+                         createIndex(static_cast<int>(lastChanged) + 1, 1),
+                         {Qt::DisplayRole, YValueRole});
+    }
+
+    if(newCount > oldCount)
+    {
+        beginInsertRows(QModelIndex(), static_cast<int>(oldCount) + 1, static_cast<int>(newCount));
+        m_rows.reserve(newCount);
+        for(qsizetype i = oldCount; i < newCount; ++i)
+        {
+            m_rows.push_back(makeRow(static_cast<int>(i) + 1, values[i]));
+        }
+        endInsertRows();
+    }
+}
+
+RawDataModel::Row RawDataModel::makeRow(int cycle, float value)
+{
+    Row row;
+    row.cycle = QString::number(cycle);
+    row.intensity = QString("%1").arg(value);
+    row.value = value;
+    return row;
 }
@@ -0,0 +1,89 @@
+#include "RegressionAccumulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void RegressionAccumulator::add(double x, double y)
+{
+    ++m_count;
+    double dx = x - m_meanX;
+    double dy = y - m_meanY;
+    m_meanX += dx / m_count;
+    m_meanY += dy / m_count;
+
+    m_ssXX += dx * (x - m_meanX);
+    m_ssYY += dy * (y - m_meanY);
+    m_ssXY += dx * (y - m_meanY);
+}
+
+void RegressionAccumulator::remove(double x, double y)
+{
+    if (m_count <= 1) {
+        reset();
+        return;
+    }
+
+    double dx = x - m_meanX;
+    double dy = y - m_meanY;
+    --m_count;
+    m_meanX -= dx / m_count;
+    m_meanY -= dy / m_count;
+
+    m_ssXX -= dx * (x - m_meanX);
+    m_ssYY -= dy * (y - m_meanY);
+    m_ssXY -= dx * (y - m_meanY);
+
+    // Rounding must not leave a negative sum of squares behind
+    m_ssXX = std::max(m_ssXX, 0.0);
+    m_ssYY = std::max(m_ssYY, 0.0);
+}
+
+void RegressionAccumulator::reset()
+{
+    *this = RegressionAccumulator();
+}
+
+int RegressionAccumulator::count() const
+{
+    return m_count;
+}
+
+double RegressionAccumulator::meanX() const
+{
+    return m_meanX;
+}
+
+double RegressionAccumulator::meanY() const
+{
+    return m_meanY;
+}
+
+double RegressionAccumulator::ssXX() const
+{
+    return m_ssXX;
+}
+
+double RegressionAccumulator::residualSumOfSquares() const
+{
+    if (m_ssXX < 1e-9) return m_ssYY;
+    return std::max(m_ssYY - m_ssXY * m_ssXY / m_ssXX, 0.0);
+}
+
+std::tuple<double, double, double> RegressionAccumulator::fit() const
+{
+    if (m_count < 2) return {0.0, 0.0, 0.0};
+
+    // If ss_xx is 0, all X values are identical (vertical line).
+    if (std::abs(m_ssXX) < 1e-9) return {0.0, 0.0, 0.0};
+
+    double slope = m_ssXY / m_ssXX;
+    double intercept = m_meanY - slope * m_meanX;
+
+    double r_squared = 0.0;
+    if (m_ssYY > 1e-9) {
+        double r = m_ssXY / std::sqrt(m_ssXX * m_ssYY);
+        r_squared = r * r;
+    }
+
+    return {slope, intercept, r_squared};
+}
@@ -0,0 +1,100 @@
+#include "ReplicateGroups.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+double ReplicateStatistics::standardDeviation() const
+{
+    if(count < 2) return 0.0;
+    return std::sqrt(std::max(0.0, ssCycleThreshold) / (count - 1));
+}
+
+double ReplicateStatistics::coefficientOfVariation() const
+{
+    if(std::abs(meanCycleThreshold) < 1e-9) return 0.0;
+    return standardDeviation() / meanCycleThreshold * 100.0;
+}
+
+void ReplicateGroups::set(const QString& experimentName, const QString& group, bool unknown,
+                          double logConcentration, double cycleThreshold)
+{
+    remove(experimentName);
+    // No crossing, no Ct to average
+    if(group.isEmpty() || cycleThreshold < 0.0) return;
+
+    const bool missingConcentration = std::isnan(logConcentration);
+    if(missingConcentration) logConcentration = 0.0;
+
+    ReplicateStatistics& statistics = m_groups[group];
+    ++statistics.count;
+    if(unknown) ++statistics.unknownCount;
+    if(missingConcentration) ++statistics.missingConcentrationCount;
+    const double delta = cycleThreshold - statistics.meanCycleThreshold;
+    statistics.meanCycleThreshold += delta / statistics.count;
+    statistics.ssCycleThreshold += delta * (cycleThreshold - statistics.meanCycleThreshold);
+    statistics.meanLogConcentration += (logConcentration - statistics.meanLogConcentration) / statistics.count;
+
+    m_members.insert(experimentName,
+                     Member{group, unknown, missingConcentration, logConcentration, cycleThreshold});
+}
+
+void ReplicateGroups::remove(const QString& experimentName)
+{
+    const auto member = m_members.constFind(experimentName);
+    if(member == m_members.constEnd()) return;
+
+    const auto group = m_groups.find(member->group);
+    if(group->count <= 1)
+    {
+        m_groups.erase(group);
+    }
+    else
+    {
+        ReplicateStatistics& statistics = *group;
+        const double previousMean = statistics.meanCycleThreshold;
+        --statistics.count;
+        if(member->unknown) --statistics.unknownCount;
+        if(member->missingConcentration) --statistics.missingConcentrationCount;
+        statistics.meanCycleThreshold = (previousMean * (statistics.count + 1) - member->cycleThreshold) / statistics.count;
+        statistics.ssCycleThreshold -= (member->cycleThreshold - statistics.meanCycleThreshold) *
+                                       (member->cycleThreshold - previousMean);
+        statistics.meanLogConcentration = (statistics.meanLogConcentration * (statistics.count + 1) -
+                                           member->logConcentration) / statistics.count;
+    }
+    m_members.erase(member);
+}
+
+void ReplicateGroups::clear()
+{
+    m_members.clear();
+    m_groups.clear();
+}
+
+QString ReplicateGroups::groupOf(const QString& experimentName) const
+{
+    return m_members.value(experimentName).group;
+}
+
+ReplicateStatistics ReplicateGroups::statistics(const QString& group) const
+{
+    return m_groups.value(group);
+}
+
+const QMap<QString, ReplicateStatistics>& ReplicateGroups::groups() const
+{
+    return m_groups;
+}
+
+QList<QPair<double, double>> ReplicateGroups::groupMeans() const
+{
+    QList<QPair<double, double>> points;
+    for(const auto& statistics : m_groups)
+    {
+        // StandardCurveBuilder::build skips runs without a concentration, so does the mean of their group
+        if(statistics.unknownCount > 0 || statistics.missingConcentrationCount > 0) continue;
+        points.push_back(qMakePair(statistics.meanLogConcentration, statistics.meanCycleThreshold));
+    }
+    std::sort(points.begin(), points.end(),
+              [](const QPair<double, double>& a, const QPair<double, double>& b) { return a.first < b.first; });
+    return points;
+}
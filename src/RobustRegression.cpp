@@ -0,0 +1,172 @@
+#include "RobustRegression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+constexpr int MAX_ITERATIONS = 50;
+constexpr double TOLERANCE = 1e-10;
+// Scales the median absolute deviation to σ for normally distributed residuals
+constexpr double MAD_SCALE = 1.4826;
+
+// Reorders values, which must not be empty
+double median(std::vector<double>& values)
+{
+    const auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    if(values.size() % 2 == 1) return *middle;
+
+    return (*std::max_element(values.begin(), middle) + *middle) / 2.0;
+}
+
+double residualScale(const QList<QPair<double, double>>& points, double slope, double intercept)
+{
+    std::vector<double> absoluteResiduals;
+    absoluteResiduals.reserve(points.size());
+    for(const auto& [x, y] : points)
+    {
+        absoluteResiduals.push_back(std::abs(y - (intercept + slope * x)));
+    }
+    return std::max(MAD_SCALE * median(absoluteResiduals), RobustRegression::MIN_SCALE);
+}
+}
+
+int RobustFit::outlierCount() const
+{
+    return static_cast<int>(std::count(outliers.begin(), outliers.end(), true));
+}
+
+std::pair<double, double> RobustRegression::theilSen(const QList<QPair<double, double>>& points)
+{
+    std::vector<double> values;
+    values.reserve(points.size() * (points.size() - 1) / 2);
+    for(qsizetype i = 0; i < points.size(); ++i)
+    {
+        for(qsizetype j = i + 1; j < points.size(); ++j)
+        {
+            const double dx = points[j].first - points[i].first;
+            if(std::abs(dx) < 1e-12) continue;
+            values.push_back((points[j].second - points[i].second) / dx);
+        }
+    }
+    if(values.empty()) return {0.0, 0.0};
+
+    const double slope = median(values);
+    values.clear();
+    for(const auto& [x, y] : points)
+    {
+        values.push_back(y - slope * x);
+    }
+    return {slope, median(values)};
+}
+
+RobustFit RobustRegression::fit(const QList<QPair<double, double>>& points)
+{
+    RegressionAccumulator ordinary;
+    for(const auto& [x, y] : points)
+    {
+        ordinary.add(x, y);
+    }
+    return fit(points, ordinary);
+}
+
+RobustFit RobustRegression::fit(const QList<QPair<double, double>>& points, const RegressionAccumulator& ordinary)
+{
+    RobustFit result;
+    const qsizetype n = points.size();
+    if(n < 3) return result;
+
+    // No two different x values, there is no line to fit
+    const auto [minimum, maximum] = std::minmax_element(points.begin(), points.end(),
+        [](const QPair<double, double>& a, const QPair<double, double>& b) { return a.first < b.first; });
+    if(maximum->first - minimum->first < 1e-12) return result;
+
+    auto [slope, intercept] = theilSen(points);
+
+    const double scale = residualScale(points, slope, intercept);
+    // Outliers are judged against the Theil–Sen line, a far away dilution has enough
+    // leverage to pull even a Huber fit towards itself
+    result.outliers.reserve(n);
+    for(const auto& [x, y] : points)
+    {
+        result.outliers.push_back(std::abs(y - (intercept + slope * x)) > OUTLIER_CUTOFF * scale);
+    }
+    if(n - result.outlierCount() < 2) return RobustFit();
+
+    QList<double> weights(n, 1.0);
+    for(int iteration = 0; iteration < MAX_ITERATIONS; ++iteration)
+    {
+        double sumW = 0.0;
+        double sumWX = 0.0;
+        double sumWY = 0.0;
+        for(qsizetype i = 0; i < n; ++i)
+        {
+            const auto& [x, y] = points[i];
+            const double residual = std::abs(y - (intercept + slope * x));
+            if(result.outliers[i])
+            {
+                weights[i] = 0.0;
+                continue;
+            }
+            weights[i] = residual > HUBER_K * scale ? HUBER_K * scale / residual : 1.0;
+            sumW += weights[i];
+            sumWX += weights[i] * x;
+            sumWY += weights[i] * y;
+        }
+
+        const double meanX = sumWX / sumW;
+        const double meanY = sumWY / sumW;
+        double ssXX = 0.0;
+        double ssXY = 0.0;
+        for(qsizetype i = 0; i < n; ++i)
+        {
+            const double dx = points[i].first - meanX;
+            ssXX += weights[i] * dx * dx;
+            ssXY += weights[i] * dx * (points[i].second - meanY);
+        }
+        if(ssXX < 1e-12) break;
+
+        const double nextSlope = ssXY / ssXX;
+        const double nextIntercept = meanY - nextSlope * meanX;
+        const bool converged = std::abs(nextSlope - slope) < TOLERANCE * (1.0 + std::abs(slope)) &&
+                               std::abs(nextIntercept - intercept) < TOLERANCE * (1.0 + std::abs(intercept));
+        slope = nextSlope;
+        intercept = nextIntercept;
+        if(converged) break;
+    }
+
+    result.slope = slope;
+    result.intercept = intercept;
+    result.scale = scale;
+    result.weights = weights;
+
+    double sumW = 0.0;
+    double sumWY = 0.0;
+    for(qsizetype i = 0; i < n; ++i)
+    {
+        sumW += weights[i];
+        sumWY += weights[i] * points[i].second;
+    }
+    const double meanY = sumWY / sumW;
+    double ssResidual = 0.0;
+    double ssTotal = 0.0;
+    for(qsizetype i = 0; i < n; ++i)
+    {
+        const auto& [x, y] = points[i];
+        const double residual = y - (intercept + slope * x);
+        ssResidual += weights[i] * residual * residual;
+        ssTotal += weights[i] * (y - meanY) * (y - meanY);
+    }
+    // Same degenerate case as RegressionAccumulator::fit
+    result.rSquared = ssTotal > 1e-9 ? std::max(0.0, 1.0 - ssResidual / ssTotal) : 0.0;
+
+    result.leaveOneOutRSquared.reserve(n);
+    for(const auto& [x, y] : points)
+    {
+        RegressionAccumulator without = ordinary;
+        without.remove(x, y);
+        result.leaveOneOutRSquared.push_back(std::get<2>(without.fit()));
+    }
+    return result;
+}
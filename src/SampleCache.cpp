@@ -0,0 +1,89 @@
+#include "SampleCache.hpp"
+#include "ExperimentMetadata.hpp"
+
+#include <QDebug>
+
+#include <algorithm>
+
+SampleCache::SampleCache(Loader loader, int capacity, QObject* parent)
+    : QObject(parent),
+      m_loader(std::move(loader)),
+      m_capacity(std::max(1, capacity))
+{
+    // Loads are disk bound, two at a time keep the UI thread's core free
+    m_pool.setMaxThreadCount(2);
+}
+
+SampleCache::~SampleCache()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+SampleCache::Samples SampleCache::find(const QString& experimentName)
+{
+    const auto samples = m_samples.constFind(experimentName);
+    if(samples == m_samples.constEnd()) return Samples();
+
+    touch(experimentName);
+    return *samples;
+}
+
+void SampleCache::request(const QString& experimentName)
+{
+    if(m_samples.contains(experimentName) || m_loading.contains(experimentName)) return;
+
+    m_loading.insert(experimentName);
+    const int generation = m_generations.value(experimentName);
+    m_pool.start([this, experimentName, generation]() {
+        Samples samples;
+        const QByteArray content = m_loader(experimentName);
+        if(!content.isEmpty())
+        {
+            try {
+                samples.reset(new QList<float>(ExperimentMetadataReader::readIntensityValues(content)));
+            } catch (const fkyaml::exception& e) {
+                qWarning() << "SampleCache: could not read" << experimentName << "-" << e.what();
+            }
+        }
+        QMetaObject::invokeMethod(this, [this, experimentName, generation, samples]() {
+            onLoaded(experimentName, generation, samples);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void SampleCache::invalidate(const QString& experimentName)
+{
+    ++m_generations[experimentName];
+    m_samples.remove(experimentName);
+    m_recent.removeOne(experimentName);
+}
+
+void SampleCache::onLoaded(const QString& experimentName, int generation, const Samples& samples)
+{
+    m_loading.remove(experimentName);
+    if(generation != m_generations.value(experimentName))
+    {
+        // The file changed while it was read
+        request(experimentName);
+        return;
+    }
+
+    if(samples)
+    {
+        m_samples.insert(experimentName, samples);
+        touch(experimentName);
+        while(m_recent.size() > m_capacity)
+        {
+            m_samples.remove(m_recent.takeFirst());
+        }
+    }
+    emit loaded(experimentName);
+}
+
+void SampleCache::touch(const QString& experimentName)
+{
+    // The cache holds a few dozen names at most, a linear search is cheaper than a linked hash
+    m_recent.removeOne(experimentName);
+    m_recent.push_back(experimentName);
+}
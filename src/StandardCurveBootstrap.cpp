@@ -0,0 +1,177 @@
+#include "StandardCurveBootstrap.hpp"
+#include "ExperimentAnalysis.hpp"
+#include "RegressionAccumulator.hpp"
+#include "Xoshiro256.hpp"
+
+#include <QSemaphore>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+constexpr int LANES = 8;
+
+// Reorders values, which must not be empty
+ConfidenceInterval percentileInterval(std::vector<double>& values)
+{
+    const auto at = [&values](double fraction) {
+        const auto nth = values.begin() + static_cast<std::ptrdiff_t>(fraction * (values.size() - 1) + 0.5);
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+    };
+    return {at(0.025), at(0.975)};
+}
+
+double jackknifeStandardError(const std::vector<double>& estimates)
+{
+    const double n = static_cast<double>(estimates.size());
+    double mean = 0.0;
+    for(const double estimate : estimates)
+    {
+        mean += estimate;
+    }
+    mean /= n;
+
+    double sumOfSquares = 0.0;
+    for(const double estimate : estimates)
+    {
+        sumOfSquares += (estimate - mean) * (estimate - mean);
+    }
+    return std::sqrt((n - 1.0) / n * sumOfSquares);
+}
+}
+
+bool ConfidenceInterval::contains(double value) const
+{
+    return value >= lower && value <= upper;
+}
+
+StandardCurveIntervals StandardCurveBootstrap::compute(const QList<QPair<double, double>>& points, QThreadPool& pool,
+                                                       int resamples, std::uint64_t seed)
+{
+    StandardCurveIntervals result;
+    const int n = static_cast<int>(points.size());
+    if(n < 3 || resamples < 1) return result;
+
+    // Centered copies, one array per term of the sums
+    RegressionAccumulator all;
+    for(const auto& [x, y] : points)
+    {
+        all.add(x, y);
+    }
+    if(all.ssXX() < 1e-12) return result;
+
+    std::vector<double> xs(n), ys(n), xxs(n), xys(n);
+    for(int i = 0; i < n; ++i)
+    {
+        xs[i] = points[i].first - all.meanX();
+        ys[i] = points[i].second - all.meanY();
+        xxs[i] = xs[i] * xs[i];
+        xys[i] = xs[i] * ys[i];
+    }
+
+    // NaN marks a resample whose points all had the same x
+    std::vector<double> slopes(static_cast<size_t>(resamples));
+    std::vector<double> intercepts(static_cast<size_t>(resamples));
+    const int blockCount = std::min(BLOCKS, resamples);
+    // Counts finished blocks, waitForDone() would also wait for everything else queued on the pool
+    QSemaphore finished;
+    for(int block = 0; block < blockCount; ++block)
+    {
+        const int begin = static_cast<int>(static_cast<std::int64_t>(resamples) * block / blockCount);
+        const int end = static_cast<int>(static_cast<std::int64_t>(resamples) * (block + 1) / blockCount);
+        pool.start([&, block, begin, end]() {
+            Xoshiro256 random(seed);
+            for(int jump = 0; jump < block; ++jump)
+            {
+                random.jump();
+            }
+
+            // LANES resamples at a time, counts[i * LANES + lane]: the sums of every lane are
+            // independent, so the loops over lanes vectorize without reordering any sum
+            std::vector<double> counts(static_cast<size_t>(n) * LANES);
+            for(int first = begin; first < end; first += LANES)
+            {
+                std::fill(counts.begin(), counts.end(), 0.0);
+                for(int lane = 0; lane < LANES; ++lane)
+                {
+                    for(int draw = 0; draw < n; ++draw)
+                    {
+                        counts[random.below(static_cast<std::uint32_t>(n)) * LANES + lane] += 1.0;
+                    }
+                }
+
+                double sumX[LANES] = {};
+                double sumY[LANES] = {};
+                double sumXX[LANES] = {};
+                double sumXY[LANES] = {};
+                for(int i = 0; i < n; ++i)
+                {
+                    const double* count = counts.data() + static_cast<size_t>(i) * LANES;
+                    for(int lane = 0; lane < LANES; ++lane)
+                    {
+                        sumX[lane] += count[lane] * xs[i];
+                        sumY[lane] += count[lane] * ys[i];
+                        sumXX[lane] += count[lane] * xxs[i];
+                        sumXY[lane] += count[lane] * xys[i];
+                    }
+                }
+
+                for(int lane = 0; lane < LANES && first + lane < end; ++lane)
+                {
+                    const int resample = first + lane;
+                    const double denominator = n * sumXX[lane] - sumX[lane] * sumX[lane];
+                    if(denominator < 1e-12 * n * n)
+                    {
+                        slopes[resample] = std::numeric_limits<double>::quiet_NaN();
+                        continue;
+                    }
+                    const double slope = (n * sumXY[lane] - sumX[lane] * sumY[lane]) / denominator;
+                    slopes[resample] = slope;
+                    // Back from the centered coordinates
+                    intercepts[resample] = all.meanY() + (sumY[lane] - slope * sumX[lane]) / n - slope * all.meanX();
+                }
+            }
+            finished.release();
+        });
+    }
+    finished.acquire(blockCount);
+
+    std::vector<double> validSlopes;
+    std::vector<double> validIntercepts;
+    std::vector<double> efficiencies;
+    validSlopes.reserve(slopes.size());
+    validIntercepts.reserve(slopes.size());
+    efficiencies.reserve(slopes.size());
+    for(size_t i = 0; i < slopes.size(); ++i)
+    {
+        if(std::isnan(slopes[i])) continue;
+        validSlopes.push_back(slopes[i]);
+        validIntercepts.push_back(intercepts[i]);
+        efficiencies.push_back(ExperimentAnalysis::calculatePCREfficiency(slopes[i]));
+    }
+    if(validSlopes.empty()) return result;
+
+    result.pointCount = n;
+    result.resamples = static_cast<int>(validSlopes.size());
+    result.slope = percentileInterval(validSlopes);
+    result.intercept = percentileInterval(validIntercepts);
+    result.efficiency = percentileInterval(efficiencies);
+
+    std::vector<double> jackknifeSlopes;
+    std::vector<double> jackknifeIntercepts;
+    for(const auto& [x, y] : points)
+    {
+        RegressionAccumulator without = all;
+        without.remove(x, y);
+        const auto [slope, intercept, rSquared] = without.fit();
+        jackknifeSlopes.push_back(slope);
+        jackknifeIntercepts.push_back(intercept);
+    }
+    result.slopeStandardError = jackknifeStandardError(jackknifeSlopes);
+    result.interceptStandardError = jackknifeStandardError(jackknifeIntercepts);
+    result.valid = true;
+    return result;
+}
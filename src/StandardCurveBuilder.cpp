@@ -0,0 +1,27 @@
+#include "StandardCurveBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+StandardCurveBuild StandardCurveBuilder::build(const QList<ExperimentMetadata>& runs)
+{
+    StandardCurveBuild result;
+    result.points.reserve(runs.size());
+    for(const auto& run : runs)
+    {
+        // An unknown has no known concentration, a run that never crossed has no Ct
+        if(run.sampleType == "unknown" || run.cycleThreshold <= 0.0 || run.concentration <= 0.0)
+        {
+            ++result.skipped;
+            continue;
+        }
+
+        const double x = std::log10(run.concentration);
+        result.points.push_back(qMakePair(x, run.cycleThreshold));
+        result.regression.add(x, run.cycleThreshold);
+    }
+
+    std::sort(result.points.begin(), result.points.end(),
+              [](const QPair<double, double>& a, const QPair<double, double>& b) { return a.first < b.first; });
+    return result;
+}
@@ -1,15 +1,26 @@
 #include "StandardCurveModel.hpp"
 
+#include <algorithm>
+
 StandardCurveModel::StandardCurveModel(QSharedPointer<DataManager> dataManager)
-    : m_dataManager{dataManager}
+    : m_dataManager{dataManager},
+    m_rowCount{static_cast<int>(dataManager->getXyLogStandardCurve().size())}
 {
     connect(m_dataManager.data(), &DataManager::xyLogStandardCurveUpdated,
             this, &StandardCurveModel::refreshModel);
+    connect(m_dataManager.data(), &DataManager::standardCurvePointInserted,
+            this, &StandardCurveModel::onPointInserted);
+    connect(m_dataManager.data(), &DataManager::standardCurvePointRemoved,
+            this, &StandardCurveModel::onPointRemoved);
+    connect(m_dataManager.data(), &DataManager::standardCurveFitChanged,
+            this, &StandardCurveModel::onFitChanged);
+
+    onFitChanged();
 }
 
 int StandardCurveModel::rowCount(const QModelIndex &) const
 {
-    return m_dataManager->getXyLogStandardCurve().size();
+    return m_rowCount;
 }
 
 int StandardCurveModel::columnCount(const QModelIndex &) const
@@ -25,13 +36,13 @@ QVariant StandardCurveModel::data(const QModelIndex &index, int role) const
     }
 
     // Bounds check to prevent crashes
-    auto standardCurvePoints = m_dataManager->getXyLogStandardCurve();
+    const auto& standardCurvePoints = m_dataManager->getXyLogStandardCurve();
     if (index.row() < 0 || index.row() >= standardCurvePoints.size())
     {
         return QVariant();
     }
 
-    auto point = standardCurvePoints[index.row()];
+    const auto& point = standardCurvePoints[index.row()];
 
     // VXYModelMapper requests Qt::DisplayRole.
     // It distinguishes X and Y based on the column index you set in QML (xColumn: 0, yColumn: 1).
@@ -58,37 +69,88 @@ QHash<int, QByteArray> StandardCurveModel::roleNames() const
     return roles;
 }
 
-void StandardCurveModel::onStandardCurveUpdated(int index, float value)
+bool StandardCurveModel::fitValid() const
 {
-    // Check if this index is a new row or an update to an existing row
-    // Note: rowCount() calls m_dataManager->size().
-    // If DataManager is already updated, rowCount() returns the NEW size.
-    int currentSize = m_dataManager->getXyLogStandardCurve().size();
+    return m_fitValid;
+}
 
-    // If the index matches the last element, we assume it's an append
-    if (index == currentSize - 1)
-    {
-        // We must tell the view we are adding a row.
-        // Even if DataManager already has the data, we strictly wrap the notification
-        // so the View updates its internal mapping.
+QPointF StandardCurveModel::fitStart() const
+{
+    return m_fitStart;
+}
 
-        // "index" is the position of the new row.
-        beginInsertRows(QModelIndex(), index, index);
-        endInsertRows();
-    }
-    else
-    {
-        // It is an update to an existing point
-        QModelIndex startIndex = createIndex(index, 0); // Column 0 (X)
-        QModelIndex endIndex = createIndex(index, 1);   // Column 1 (Y)
+QPointF StandardCurveModel::fitEnd() const
+{
+    return m_fitEnd;
+}
+
+void StandardCurveModel::onPointInserted(int index)
+{
+    if (index < 0 || index > m_rowCount) return;
+
+    beginInsertRows(QModelIndex(), index, index);
+    ++m_rowCount;
+    endInsertRows();
+}
+
+void StandardCurveModel::onPointRemoved(int index)
+{
+    if (index < 0 || index >= m_rowCount) return;
 
-        // Notify that both columns changed
-        emit dataChanged(startIndex, endIndex, {Qt::DisplayRole});
+    beginRemoveRows(QModelIndex(), index, index);
+    --m_rowCount;
+    endRemoveRows();
+}
+
+void StandardCurveModel::onFitChanged()
+{
+    const auto& points = m_dataManager->getXyLogStandardCurve();
+    // Same minimum as the reported fit
+    const bool valid = points.size() >= 5;
+
+    QPointF start;
+    QPointF end;
+    if (valid)
+    {
+        // Points are sorted by log concentration
+        const double firstX = points.front().first;
+        const double lastX = points.back().first;
+        // The reported ordinary fit, the robust one only flags outliers
+        const double slope = m_dataManager->m_slope;
+        const double intercept = m_dataManager->m_yIntercept;
+        start = QPointF(firstX, intercept + slope * firstX);
+        end = QPointF(lastX, intercept + slope * lastX);
     }
+    if (valid == m_fitValid && start == m_fitStart && end == m_fitEnd) return;
+
+    m_fitValid = valid;
+    m_fitStart = start;
+    m_fitEnd = end;
+    emit fitChanged();
 }
 
 void StandardCurveModel::refreshModel()
 {
-    beginResetModel();
-    endResetModel();
+    const int newCount = static_cast<int>(m_dataManager->getXyLogStandardCurve().size());
+    const int keptCount = std::min(m_rowCount, newCount);
+
+    if (newCount < m_rowCount)
+    {
+        beginRemoveRows(QModelIndex(), newCount, m_rowCount - 1);
+        m_rowCount = newCount;
+        endRemoveRows();
+    }
+
+    // The points that stayed may all have moved, one range covers them
+    if (keptCount > 0)
+    {
+        emit dataChanged(createIndex(0, 0), createIndex(keptCount - 1, 1), {Qt::DisplayRole});
+    }
+
+    if (newCount > m_rowCount)
+    {
+        beginInsertRows(QModelIndex(), m_rowCount, newCount - 1);
+        m_rowCount = newCount;
+        endInsertRows();
+    }
 }
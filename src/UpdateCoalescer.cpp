@@ -0,0 +1,70 @@
+#include "UpdateCoalescer.hpp"
+
+#include <algorithm>
+
+UpdateCoalescer::UpdateCoalescer(int intervalMs, QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(intervalMs);
+    connect(&m_timer, &QTimer::timeout, this, &UpdateCoalescer::flush);
+}
+
+void UpdateCoalescer::markRows(int first, int last)
+{
+    if(last < first) return;
+
+    // First range that ends at or right before first, everything from there that touches [first, last] is merged
+    auto range = std::lower_bound(m_rows.begin(), m_rows.end(), first - 1,
+                                  [](const QPair<int, int>& rows, int row) { return rows.second < row; });
+    auto end = range;
+    while(end != m_rows.end() && end->first <= last + 1)
+    {
+        first = std::min(first, end->first);
+        last = std::max(last, end->second);
+        ++end;
+    }
+    range = m_rows.erase(range, end);
+    m_rows.insert(range, qMakePair(first, last));
+    schedule();
+}
+
+void UpdateCoalescer::markNotification(const QObject* sender, int methodIndex, std::function<void()> emitSignal)
+{
+    for(auto& notification : m_notifications)
+    {
+        if(notification.sender == sender && notification.methodIndex == methodIndex)
+        {
+            notification.emitSignal = std::move(emitSignal);
+            return;
+        }
+    }
+    m_notifications.push_back(Notification{sender, methodIndex, std::move(emitSignal)});
+    schedule();
+}
+
+void UpdateCoalescer::flush()
+{
+    m_timer.stop();
+
+    // Taken first, a receiver may mark again while they are sent
+    const QList<QPair<int, int>> rows = std::exchange(m_rows, {});
+    const QList<Notification> notifications = std::exchange(m_notifications, {});
+    for(const auto& [first, last] : rows)
+    {
+        emit rowsChanged(first, last);
+    }
+    for(const auto& notification : notifications)
+    {
+        notification.emitSignal();
+    }
+}
+
+void UpdateCoalescer::schedule()
+{
+    if(!m_timer.isActive())
+    {
+        m_timer.start();
+    }
+}
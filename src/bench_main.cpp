@@ -0,0 +1,307 @@
+#include "CtEngine.hpp"
+#include "Quantification.hpp"
+#include "RegressionAccumulator.hpp"
+#include "StandardCurveBootstrap.hpp"
+
+#include "fkYAML.hpp"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * gwi-bench: reproducible timings of the analysis hot paths.
+ *
+ *   gwi-bench [--runs <n>] [<experiments folder>]
+ *
+ * Every timing is the best of --runs repetitions (default 5), on one thread
+ * unless noted otherwise, so runs on the same machine can be compared. Inputs
+ * are either the saved experiments (resources/experiments of the source tree
+ * by default) or generated from fixed formulas, never random.
+ *
+ * YAML parsing: the experiments and a generated experiment with a long
+ * light_sensor_data sequence are parsed with the numeric fast path of
+ * fkYAML.hpp and with the same parser built without it
+ * (FK_YAML_NUMERIC_FAST_PATH=0, src/bench_yaml_no_fast_path.cpp). Both must
+ * produce the same document.
+ *
+ * Ct: CtEngine::computeCt over a plate of generated curves against
+ * CtEngine::findCycleThreshold once per curve, in ns per Ct.
+ *
+ * Quantification: Quantification::quantifyBatch against quantify() once per
+ * Ct, in ns per Ct, and the 10000 resample StandardCurveBootstrap on its
+ * thread pool (all cores) and on one thread.
+ */
+
+// src/bench_yaml_no_fast_path.cpp
+namespace YamlWithoutFastPath {
+size_t parse(const std::string& text);
+std::string parseAndSerialize(const std::string& text);
+}
+
+namespace {
+struct Document
+{
+    std::string name;
+    std::string text;
+};
+
+// Six point dilution series of resources/experiments/first_experiment.yml
+const QList<QPair<double, double>> STANDARD_CURVE{{-4.3, 34.0}, {-3.3, 31.0}, {-2.3, 28.0},
+                                                  {-1.3, 25.0}, {-0.3, 22.0}, {0.7, 18.0}};
+
+// Timed results are added up here, so the compiler cannot drop the work
+volatile double benchSink = 0.0;
+
+// Best wall time of runs calls of work, in seconds
+template<typename Work>
+double bestOf(int runs, Work&& work)
+{
+    double best = 0.0;
+    for(int run = 0; run < runs; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        work();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if(run == 0 || elapsed.count() < best)
+        {
+            best = elapsed.count();
+        }
+    }
+    return best;
+}
+
+void report(const std::string& name, double seconds, double bytes)
+{
+    std::cout << name << ": " << seconds * 1e3 << " ms, " << bytes / 1024.0 / 1024.0 / seconds << " MiB/s\n";
+}
+
+void reportPerItem(const std::string& name, double seconds, double items)
+{
+    std::cout << name << ": " << seconds * 1e3 << " ms, " << seconds * 1e9 / items << " ns per Ct\n";
+}
+
+std::vector<Document> readExperiments(const QString& folder)
+{
+    std::vector<Document> documents;
+    const QStringList names = QDir(folder).entryList({"*.yml"}, QDir::Files, QDir::Name);
+    for(const QString& name : names)
+    {
+        QFile file(QDir(folder).filePath(name));
+        if(file.open(QIODevice::ReadOnly))
+        {
+            documents.push_back({name.toStdString(), file.readAll().toStdString()});
+        }
+    }
+    return documents;
+}
+
+// Experiment with readings light_sensor_data values of a sigmoid amplification curve
+std::string generatedExperiment(int readings)
+{
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(2);
+    text << "experiment_name: generated\nintensity_threshold: 1.1\nlight_sensor_data:\n";
+    for(int i = 0; i < readings; ++i)
+    {
+        const int cycle = i % 40;
+        text << "- " << 250.0 - 240.0 / (1.0 + std::exp(-(cycle - 20.0) / 2.5)) + (i % 7) * 0.01 << "\n";
+    }
+    text << "max_cycle: 40\nr_squared: 0.991758\nslope: -3.32\n";
+    return text.str();
+}
+
+bool benchYaml(const std::vector<Document>& documents, int runs)
+{
+    bool same = true;
+    for(const Document& document : documents)
+    {
+        if(fkyaml::node::serialize(fkyaml::node::deserialize(document.text)) !=
+           YamlWithoutFastPath::parseAndSerialize(document.text))
+        {
+            std::cerr << "gwi-bench: " << document.name << " parses differently without the fast path\n";
+            same = false;
+        }
+    }
+
+    double bytes = 0.0;
+    for(const Document& document : documents)
+    {
+        bytes += document.text.size();
+    }
+    // Small files finish in microseconds, each run parses them often enough to be measurable
+    const int repeat = std::max(1, static_cast<int>(4 * 1024 * 1024 / std::max(bytes, 1.0)));
+
+    size_t sink = 0;
+    const double fast = bestOf(runs, [&]() {
+        for(int i = 0; i < repeat; ++i)
+        {
+            for(const Document& document : documents)
+            {
+                sink += fkyaml::node::deserialize(document.text).size();
+            }
+        }
+    });
+    const double generic = bestOf(runs, [&]() {
+        for(int i = 0; i < repeat; ++i)
+        {
+            for(const Document& document : documents)
+            {
+                sink += YamlWithoutFastPath::parse(document.text);
+            }
+        }
+    });
+
+    std::cout << "YAML parse, " << documents.size() << " documents x " << repeat << " (" << sink
+              << " top-level keys)\n";
+    report("  with numeric fast path", fast, bytes * repeat);
+    report("  without numeric fast path", generic, bytes * repeat);
+    std::cout << "  speedup: " << generic / fast << "x\n";
+    return same;
+}
+
+
+// Rising sigmoid whose midpoint moves from cycle 12 to 36 across the wells, the last wells never cross 50
+QList<float> amplificationCurve(int well, int wellCount, int cycleCount)
+{
+    const double midpoint = 12.0 + 24.0 * well / std::max(1, wellCount - 1);
+    QList<float> curve;
+    curve.reserve(cycleCount);
+    for(int cycle = 1; cycle <= cycleCount; ++cycle)
+    {
+        curve.push_back(static_cast<float>(5.0 + 95.0 / (1.0 + std::exp(-(cycle - midpoint) / 2.0))));
+    }
+    return curve;
+}
+
+void benchCt(int runs)
+{
+    constexpr int WELLS = 9600;
+    constexpr int CYCLES = 45;
+    constexpr double THRESHOLD = 50.0;
+
+    CtEngine engine(WELLS, CYCLES);
+    std::vector<QList<float>> curves;
+    curves.reserve(WELLS);
+    for(int well = 0; well < WELLS; ++well)
+    {
+        curves.push_back(amplificationCurve(well, WELLS, CYCLES));
+        engine.setCurve(well, curves.back());
+    }
+
+    std::vector<double> ct;
+    double sink = 0.0;
+    std::cout << "Ct, " << WELLS << " wells x " << CYCLES << " cycles\n";
+    for(const auto interpolation : {CtEngine::Interpolation::Linear, CtEngine::Interpolation::LogLinear})
+    {
+        const std::string name = interpolation == CtEngine::Interpolation::Linear ? "linear" : "log-linear";
+        const double batched = bestOf(runs, [&]() {
+            engine.computeCt(THRESHOLD, interpolation, ct);
+            sink += ct.back();
+        });
+        const double single = bestOf(runs, [&]() {
+            for(const QList<float>& curve : curves)
+            {
+                sink += CtEngine::findCycleThreshold(curve, THRESHOLD, interpolation);
+            }
+        });
+        reportPerItem("  computeCt, " + name, batched, WELLS);
+        reportPerItem("  findCycleThreshold per well, " + name, single, WELLS);
+    }
+    benchSink = benchSink + sink;
+}
+
+void benchQuantification(int runs)
+{
+    constexpr std::size_t COUNT = 1000000;
+
+    RegressionAccumulator regression;
+    for(const auto& [x, y] : STANDARD_CURVE)
+    {
+        regression.add(x, y);
+    }
+    const CalibrationCurve curve = Quantification::calibrationCurve(regression);
+    std::vector<double> cycleThresholds(COUNT);
+    for(std::size_t i = 0; i < COUNT; ++i)
+    {
+        // Mostly 15..35, every 64th has no crossing
+        cycleThresholds[i] = i % 64 == 0 ? -1.0 : 15.0 + 20.0 * (i % 1000) / 1000.0;
+    }
+
+    std::vector<double> logQuantity(COUNT);
+    std::vector<double> halfWidth(COUNT);
+    double sink = 0.0;
+    const double batched = bestOf(runs, [&]() {
+        Quantification::quantifyBatch(curve, cycleThresholds.data(), COUNT, logQuantity.data(), halfWidth.data());
+        sink += logQuantity[1];
+    });
+    const double single = bestOf(runs, [&]() {
+        for(const double cycleThreshold : cycleThresholds)
+        {
+            sink += Quantification::quantify(curve, cycleThreshold).logQuantity;
+        }
+    });
+    std::cout << "Quantification, " << COUNT << " Ct values\n";
+    reportPerItem("  quantifyBatch", batched, COUNT);
+    reportPerItem("  quantify per Ct", single, COUNT);
+
+    QThreadPool pool;
+    QThreadPool singleThread;
+    singleThread.setMaxThreadCount(1);
+    for(QThreadPool* bootstrapPool : {&pool, &singleThread})
+    {
+        StandardCurveIntervals intervals;
+        const double seconds = bestOf(runs, [&]() {
+            intervals = StandardCurveBootstrap::compute(STANDARD_CURVE, *bootstrapPool);
+        });
+        std::cout << "  bootstrap, " << intervals.resamples << " resamples on " << bootstrapPool->maxThreadCount()
+                  << " threads: " << seconds * 1e3 << " ms, " << seconds * 1e6 / std::max(intervals.resamples, 1)
+                  << " us per resample\n";
+    }
+    benchSink = benchSink + sink;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("gwi-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Reproducible timings of YAML parsing, Ct and quantification.");
+    parser.addHelpOption();
+    QCommandLineOption runsOption("runs", "Repetitions per timing, the best one is reported (default: 5).", "n", "5");
+    parser.addOption(runsOption);
+    parser.addPositionalArgument("experiments", "Folder with saved experiments (default: resources/experiments).",
+                                 "[experiments]");
+    parser.process(app);
+
+    const int runs = std::max(1, parser.value(runsOption).toInt());
+    const QStringList positional = parser.positionalArguments();
+    const QString folder = positional.isEmpty() ? QStringLiteral(GWI_BENCH_EXPERIMENTS) : positional.front();
+
+    const std::vector<Document> experiments = readExperiments(folder);
+    if(experiments.empty())
+    {
+        std::cerr << "gwi-bench: no experiments in " << folder.toStdString() << "\n";
+        return 2;
+    }
+
+    bool ok = benchYaml(experiments, runs);
+    ok = benchYaml({{"generated", generatedExperiment(100000)}}, runs) && ok;
+    benchCt(runs);
+    benchQuantification(runs);
+
+    return ok ? 0 : 1;
+}
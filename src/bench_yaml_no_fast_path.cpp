@@ -0,0 +1,17 @@
+// Built with FK_YAML_NUMERIC_FAST_PATH=0, see the gwi-bench target. fkYAML then lives in its own inline namespace and
+// links next to the default build in the other gwi-bench sources. Include nothing else that includes fkYAML.hpp here.
+#include "fkYAML.hpp"
+
+#include <string>
+
+namespace YamlWithoutFastPath {
+size_t parse(const std::string& text)
+{
+    return fkyaml::node::deserialize(text).size();
+}
+
+std::string parseAndSerialize(const std::string& text)
+{
+    return fkyaml::node::serialize(fkyaml::node::deserialize(text));
+}
+}
@@ -0,0 +1,385 @@
+#include "ExperimentAnalysis.hpp"
+#include "Quantification.hpp"
+#include "RegressionAccumulator.hpp"
+
+#include "fkYAML.hpp"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <vector>
+
+/**
+ * gwi-cli: re-analyze saved experiments without the GUI.
+ *
+ *   gwi-cli [--threshold <lux> | --auto-threshold] [--model 4pl|5pl|none]
+ *           [--curve <experiment>] [--output <dir>] [--jobs <n>]
+ *           <experiment files or folders>...
+ *
+ * Folders contribute their *.yml files and archived *.z files. Every
+ * experiment is re-thresholded and refitted on a thread pool, the results are
+ * printed as CSV on stdout in input order, whatever order the threads finish
+ * in, so two runs over the same files give the same output. With --output the
+ * re-analyzed experiments are written there as <name>.yml, the inputs are
+ * never modified. Two inputs with the same name (foo.yml and an archived foo.z)
+ * are rejected up front instead of overwriting each other. With --curve every
+ * experiment is also quantified against the standard curve saved in that
+ * experiment. A standard curve over all experiments and the throughput go to
+ * stderr.
+ */
+
+namespace {
+struct CliOptions
+{
+    std::optional<double> intensityThreshold;
+    bool autoThreshold{false};
+    bool fitCurve{true};
+    CurveFitter::Model model{CurveFitter::Model::FiveParameter};
+    QString outputDir;
+    CalibrationCurve curve;
+};
+
+struct ExperimentResult
+{
+    QString name;
+    QString error;
+    qint64 bytes{0};
+    double concentration{0.0};
+    QString sampleType{"standard"};
+    AnalysisSettings settings;
+    AnalysisResult analysis;
+};
+
+QStringList collectInputs(const QStringList& arguments)
+{
+    QStringList paths;
+    for(const auto& argument : arguments)
+    {
+        const QFileInfo info(argument);
+        if(!info.isDir())
+        {
+            paths << info.absoluteFilePath();
+            continue;
+        }
+
+        // Sorted, so a folder always gives the same order
+        const QDir dir(info.absoluteFilePath());
+        for(const auto& fileName : dir.entryList(QStringList() << "*.yml" << "*.z", QDir::Files, QDir::Name))
+        {
+            paths << dir.absoluteFilePath(fileName);
+        }
+    }
+    return paths;
+}
+
+// First pair of inputs that would be written to the same <name>.yml, e.g. foo.yml and its archived foo.z
+std::optional<QPair<QString, QString>> duplicateOutput(const QStringList& paths)
+{
+    QHash<QString, QString> pathByName;
+    for(const auto& path : paths)
+    {
+        const QString name = QFileInfo(path).completeBaseName();
+        const auto existing = pathByName.constFind(name);
+        if(existing != pathByName.constEnd())
+        {
+            return qMakePair(existing.value(), path);
+        }
+        pathByName.insert(name, path);
+    }
+    return std::nullopt;
+}
+
+ExperimentResult analyzeExperiment(const QString& path, const CliOptions& options)
+{
+    ExperimentResult result;
+    const QFileInfo info(path);
+    result.name = info.completeBaseName();
+
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        result.error = file.errorString();
+        return result;
+    }
+    QByteArray content = file.readAll();
+    result.bytes = content.size();
+    // Archived experiments, see ExperimentArchive
+    if(info.suffix() == "z")
+    {
+        content = qUncompress(content);
+    }
+
+    try {
+        fkyaml::node root = fkyaml::node::deserialize(content.toStdString());
+
+        result.settings = ExperimentAnalysis::settingsOf(root);
+        if(options.intensityThreshold)
+        {
+            result.settings.intensityThreshold = *options.intensityThreshold;
+            result.settings.autoThreshold = false;
+        }
+        if(options.autoThreshold)
+        {
+            result.settings.autoThreshold = true;
+        }
+        result.settings.fitCurve = options.fitCurve;
+        result.settings.model = options.model;
+
+        result.concentration = ExperimentAnalysis::numberValue(root["concentration_coefficient"]) *
+                               ExperimentAnalysis::numberValue(root["concentration_multiplier"]);
+        if(root.contains("sample_type"))
+        {
+            result.sampleType = QString::fromStdString(root["sample_type"].as_str());
+        }
+        result.analysis = ExperimentAnalysis::analyze(ExperimentAnalysis::intensityValuesOf(root), result.settings);
+
+        if(!options.outputDir.isEmpty())
+        {
+            ExperimentAnalysis::store(result.analysis, result.settings, root);
+            std::ofstream ofs(QDir(options.outputDir).absoluteFilePath(result.name + ".yml").toStdString());
+            ofs << root;
+            if(!ofs)
+            {
+                result.error = "could not write to " + options.outputDir;
+            }
+        }
+    } catch (const fkyaml::exception& e) {
+        result.error = e.what();
+    }
+    return result;
+}
+
+// Standard curve saved in an experiment file, refitted like DataManager::calculateStandardCurve
+std::optional<CalibrationCurve> loadCurve(const QString& path)
+{
+    std::ifstream ifs(path.toStdString());
+    if(!ifs) return std::nullopt;
+
+    try {
+        const fkyaml::node root = fkyaml::node::deserialize(ifs);
+        RegressionAccumulator regression;
+        for(const auto& point : root["standard_curve_points"].as_seq())
+        {
+            regression.add(ExperimentAnalysis::numberValue(point[0]), ExperimentAnalysis::numberValue(point[1]));
+        }
+        return Quantification::calibrationCurve(regression);
+    } catch (const fkyaml::exception&) {
+        return std::nullopt;
+    }
+}
+
+/**
+ * Collects results from the worker threads and prints them in input order as
+ * soon as every earlier result is in, so the output streams while the pool is
+ * still busy and only the out of order results are ever held.
+ */
+class OrderedWriter
+{
+public:
+    OrderedWriter(qsizetype count, const CalibrationCurve& curve)
+        : m_results(static_cast<size_t>(count)),
+        m_curve{curve}
+    {
+        std::cout << "name,intensity_threshold,auto_threshold,cycle_threshold,"
+                     "fit_parameters,converged,plateau,second_derivative_maximum,efficiency,"
+                     "sample_type,quantity,quantity_lower,quantity_upper\n";
+    }
+
+    void finish(qsizetype index, ExperimentResult&& result)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_results[static_cast<size_t>(index)] = std::move(result);
+        while(m_next < m_results.size() && m_results[m_next])
+        {
+            write(*m_results[m_next]);
+            m_results[m_next].reset();
+            ++m_next;
+        }
+    }
+
+    int failed() const { return m_failed; }
+    qint64 bytes() const { return m_bytes; }
+    const RegressionAccumulator& standardCurve() const { return m_standardCurve; }
+
+private:
+    void write(const ExperimentResult& result)
+    {
+        m_bytes += result.bytes;
+        if(!result.error.isEmpty())
+        {
+            ++m_failed;
+            std::cerr << "gwi-cli: " << result.name.toStdString() << ": " << result.error.toStdString() << "\n";
+            return;
+        }
+
+        const AnalysisResult& analysis = result.analysis;
+        const CurveFit& curveFit = analysis.curveFit;
+        std::ostringstream row;
+        row.precision(10);
+        row << result.name.toStdString() << ',' << analysis.intensityThreshold << ','
+            << (result.settings.autoThreshold ? "true" : "false") << ',' << analysis.cycleThreshold << ','
+            << curveFit.parameterCount << ',' << (curveFit.converged ? "true" : "false") << ','
+            << curveFit.plateau << ',' << curveFit.secondDerivativeMaximum << ',' << curveFit.efficiency << ','
+            << result.sampleType.toStdString();
+        // Left empty without --curve or without a Ct
+        const Quantity quantity = Quantification::quantify(m_curve, analysis.cycleThreshold);
+        if(quantity.valid)
+        {
+            row << ',' << quantity.quantity() << ',' << quantity.lower() << ',' << quantity.upper() << '\n';
+        }
+        else
+        {
+            row << ",,,\n";
+        }
+        std::cout << row.str();
+
+        if(analysis.cycleThreshold >= 0.0 && result.concentration > 0.0 && result.sampleType != "unknown")
+        {
+            m_standardCurve.add(std::log10(result.concentration), analysis.cycleThreshold);
+        }
+    }
+
+    QMutex m_mutex;
+    std::vector<std::optional<ExperimentResult>> m_results;
+    size_t m_next{0};
+    int m_failed{0};
+    qint64 m_bytes{0};
+    RegressionAccumulator m_standardCurve;
+    CalibrationCurve m_curve;
+};
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("gwi-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Re-analyze saved experiments: threshold, Ct and curve fit.");
+    parser.addHelpOption();
+    QCommandLineOption thresholdOption("threshold", "Manual intensity threshold (lux) for every experiment.", "lux");
+    QCommandLineOption autoThresholdOption("auto-threshold", "Pick the threshold from the baseline noise.");
+    QCommandLineOption modelOption("model", "Curve fit model: 4pl, 5pl (default) or none.", "model", "5pl");
+    QCommandLineOption curveOption("curve", "Quantify every experiment against the standard curve of this experiment.",
+                                   "experiment");
+    QCommandLineOption outputOption("output", "Write the re-analyzed experiments into this folder.", "dir");
+    QCommandLineOption jobsOption("jobs", "Number of worker threads (default: one per core).", "n");
+    parser.addOptions({thresholdOption, autoThresholdOption, modelOption, curveOption, outputOption, jobsOption});
+    parser.addPositionalArgument("paths", "Experiment files (.yml, archived .z) or folders.", "<paths>...");
+    parser.process(app);
+
+    CliOptions options;
+    if(parser.isSet(thresholdOption))
+    {
+        bool ok = false;
+        options.intensityThreshold = parser.value(thresholdOption).toDouble(&ok);
+        if(!ok)
+        {
+            std::cerr << "gwi-cli: --threshold needs a number\n";
+            return 2;
+        }
+    }
+    options.autoThreshold = parser.isSet(autoThresholdOption);
+    if(options.intensityThreshold && options.autoThreshold)
+    {
+        std::cerr << "gwi-cli: --threshold and --auto-threshold exclude each other\n";
+        return 2;
+    }
+
+    const QString model = parser.value(modelOption).toLower();
+    if(model == "4pl")
+    {
+        options.model = CurveFitter::Model::FourParameter;
+    }
+    else if(model == "none")
+    {
+        options.fitCurve = false;
+    }
+    else if(model != "5pl")
+    {
+        std::cerr << "gwi-cli: unknown model " << model.toStdString() << "\n";
+        return 2;
+    }
+
+    if(parser.isSet(curveOption))
+    {
+        const auto curve = loadCurve(parser.value(curveOption));
+        if(!curve || !curve->valid)
+        {
+            std::cerr << "gwi-cli: no usable standard curve in " << parser.value(curveOption).toStdString() << "\n";
+            return 2;
+        }
+        options.curve = *curve;
+    }
+
+    options.outputDir = parser.value(outputOption);
+    if(!options.outputDir.isEmpty() && !QDir().mkpath(options.outputDir))
+    {
+        std::cerr << "gwi-cli: could not create " << options.outputDir.toStdString() << "\n";
+        return 2;
+    }
+
+    const QStringList paths = collectInputs(parser.positionalArguments());
+    if(paths.isEmpty())
+    {
+        parser.showHelp(2);
+    }
+    // Both would be written by different threads to the same file
+    if(!options.outputDir.isEmpty())
+    {
+        if(const auto duplicate = duplicateOutput(paths))
+        {
+            const QString output = QFileInfo(duplicate->first).completeBaseName() + ".yml";
+            std::cerr << "gwi-cli: " << duplicate->first.toStdString() << " and " << duplicate->second.toStdString()
+                      << " would both be written to " << QDir(options.outputDir).absoluteFilePath(output).toStdString()
+                      << ", pass only one of them\n";
+            return 2;
+        }
+    }
+
+    QThreadPool pool;
+    if(parser.isSet(jobsOption))
+    {
+        pool.setMaxThreadCount(std::max(1, parser.value(jobsOption).toInt()));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    OrderedWriter writer(paths.size(), options.curve);
+    for(qsizetype i = 0; i < paths.size(); ++i)
+    {
+        pool.start([&writer, &paths, &options, i]() {
+            writer.finish(i, analyzeExperiment(paths[i], options));
+        });
+    }
+    pool.waitForDone();
+    std::cout << std::flush;
+
+    const qint64 elapsedMs = std::max<qint64>(timer.elapsed(), 1);
+    const auto [slope, intercept, rSquared] = writer.standardCurve().fit();
+    std::cerr << "Standard curve points: " << writer.standardCurve().count() << ", Slope: " << slope
+              << ", Y-intercept: " << intercept << ", R²: " << rSquared
+              << ", Efficiency: " << ExperimentAnalysis::calculatePCREfficiency(slope) << "%\n";
+    std::cerr << "Analyzed " << paths.size() << " experiments (" << writer.failed() << " failed) in "
+              << elapsedMs << " ms on " << pool.maxThreadCount() << " threads: "
+              << paths.size() * 1000.0 / elapsedMs << " experiments/s, "
+              << writer.bytes() / 1024.0 / 1024.0 * 1000.0 / elapsedMs << " MiB/s\n";
+
+    return writer.failed() == 0 ? 0 : 1;
+}
@@ -5,8 +5,12 @@
 #include "HardwareController.hpp"
 #include "RawDataModel.hpp"
 #include "ExperimentModel.hpp"
+#include "ExperimentOverlay.hpp"
+#include "ExperimentProxyModel.hpp"
 #include "StandardCurveModel.hpp"
 #include "RunButtonlEventFilter.hpp"
+#include "ExperimentImporter.hpp"
+#include "ExperimentArchive.hpp"
 
 #include "fkYAML.hpp"
 
@@ -19,7 +23,9 @@
 #include <QQuickWindow>
 #include <QListWidgetItem>
 #include <QMap>
+#include <QCommandLineParser>
 
+#include <fstream>
 #include <iostream>
 #include <cstdio>
 #include <type_traits>
@@ -42,6 +48,20 @@ static void close_files(Args... files) {
     (close_if_valid(files), ...);
 }
 
+// Import every given RDML/CSV export into the experiments folder before it is loaded.
+static void import_experiments(const QDir& experimentsDir, const QStringList& paths) {
+    std::ifstream templateFile(experimentsDir.absoluteFilePath("templates/empty_experiment.yml").toStdString());
+    if (!templateFile.is_open()) {
+        qCritical() << "Import: could not find templates/empty_experiment.yml in" << experimentsDir.absolutePath();
+        return;
+    }
+
+    ExperimentImporter importer(experimentsDir, fkyaml::node::deserialize(templateFile));
+    for (const auto& path : paths) {
+        std::cout << importer.importFile(path).toString().toStdString() << std::flush;
+    }
+}
+
 int main(int argc, char *argv[])
 {
     qputenv("QT_IM_MODULE", QByteArray("qtvirtualkeyboard"));
@@ -55,10 +75,26 @@ int main(int argc, char *argv[])
         []() { QCoreApplication::exit(-1); },
         Qt::QueuedConnection);
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption importOption("import", "Import RDML/CSV amplification data into the experiments folder.", "file");
+    parser.addOption(importOption);
+    parser.process(app);
+
     auto resourceFolderName = getenv("RESOURCE_FOLDER_PATH");
     auto mainQmlPath = QDir(resourceFolderName).filePath("../Main.qml");
 
     QDir dir = QDir(resourceFolderName).filePath("experiments");
+    if (parser.isSet(importOption)) {
+        import_experiments(dir, parser.values(importOption));
+    }
+
+    // Compress experiments that have not been opened for GWI_ARCHIVE_AFTER_DAYS (default 30, 0 disables)
+    QSharedPointer<ExperimentArchive> archive(new ExperimentArchive(dir));
+    bool archiveDaysValid = false;
+    int archiveAfterDays = qEnvironmentVariableIntValue("GWI_ARCHIVE_AFTER_DAYS", &archiveDaysValid);
+    archive->archiveStale(archiveDaysValid ? archiveAfterDays : 30);
+
     QStringList fileNames = dir.entryList(QStringList() << "*.yml", QDir::Files);
 
     QMap<QString, fkyaml::node> experiments;
@@ -72,12 +108,14 @@ int main(int argc, char *argv[])
     }
 
     StateManager stateManager;
-    QSharedPointer<DataManager> dataManager(new DataManager(experiments));
+    QSharedPointer<DataManager> dataManager(new DataManager(experiments, archive));
 
     SliderHandler sliderHandler(dataManager, &app);
     RawDataModel rawDataModel(dataManager);
     ExperimentModel experimentModel(dataManager->getExperimentNames(), dataManager);
+    ExperimentProxyModel experimentProxyModel(&experimentModel);
     StandardCurveModel standardCurveModel(dataManager);
+    ExperimentOverlay experimentOverlay(dataManager, archive, dir);
 
     // HardwareController hardwareController(0x23, 1, 18, &app);
     QSharedPointer<HardwareController> hardwareController(new HardwareController(0x23, 1, 18, &app));
@@ -90,6 +128,8 @@ int main(int argc, char *argv[])
     // HardwareController and DataManager connections
     QObject::connect(hardwareController.data(), &HardwareController::sensorDataReady,
                  dataManager.data(), &DataManager::addSensorReading);
+    QObject::connect(hardwareController.data(), &HardwareController::meltSampleReady,
+                 dataManager.data(), &DataManager::addMeltSample);
 
     // Shutdown OS (linux) or close app (non-linux) when end button is pressed
     QObject::connect(&buttonHandler, &ButtonHandler::exitApp, &app, QApplication::closeAllWindows, Qt::QueuedConnection);
@@ -101,7 +141,9 @@ int main(int argc, char *argv[])
 
     engine.rootContext()->setContextProperty("rawDataModel", &rawDataModel);
     engine.rootContext()->setContextProperty("experimentModel", &experimentModel);
+    engine.rootContext()->setContextProperty("experimentProxyModel", &experimentProxyModel);
     engine.rootContext()->setContextProperty("standardCurveModel", &standardCurveModel);
+    engine.rootContext()->setContextProperty("experimentOverlay", &experimentOverlay);
     engine.load(mainQmlPath);
 
     // install run button event filter